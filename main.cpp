@@ -18,9 +18,16 @@ int main()
         files.push_back(name);
     }
     float brightness = 0.0f, ambientStrength = 0.0f;
+    parseShape::SceneCache scenes;
+    std::string loaded;
     parseShape::Scene *scene = nullptr;
     parseShape::Shader *shader = nullptr;
     parseShape::Camera *camera = nullptr;
+    parseShape::SceneSimulation *simulation = nullptr;
+    bool simulate = false;
+    parseShape::CollisionWorld collisions;
+    parseShape::Scene *collisionScene = nullptr;
+    bool checkCollisions = false;
     window.SetStyle([]()
                     { parseShape::Nuky(); });
     bool playAnimation[5] = {false, false, false, false, false};
@@ -50,18 +57,26 @@ int main()
         }
         if (file && ImGui::Button("reload"))
         {
-            if (scene)
-                delete scene;
-            if (shader)
-                delete shader;
-            scene = parseShape::Parse(file);
+            if (simulation)
+                delete simulation;
+            simulation = nullptr;
+            simulate = false;
+            // En : Reloading the file that is shown parses it again, other files come from the cache.
+            // Tr : Gösterilen dosyayı yeniden yüklemek onu tekrar ayrıştırır, diğer dosyalar önbellekten gelir.
+            if (loaded == file)
+                scenes.Evict(file);
+            loaded = file;
+            collisions.Clear();
+            collisionScene = nullptr;
+            scene = scenes.Get(file);
+            shader = nullptr;
+            camera = nullptr;
             if(scene)
             {
                 shader = scene->GetShader();
-                scene->Update();
-                shader->Activate();
                 scene->UpdateCamera();
                 camera = scene->GetCamera();
+                simulation = new parseShape::SceneSimulation(scene);
             }
         }
 
@@ -81,11 +96,77 @@ int main()
 
         if(camera && parseShape::GUI<parseShape::Object*>(camera))
             camera->SetUniforms(shader);
+        if(scene)
+        {
+            parseShape::CullStats stats = scene->GetCullStats();
+            ImGui::Text("Visible: %u Culled: %u Occluded: %u", stats.visible, stats.culled, stats.occluded);
+            ImGui::Text("Cached: %zu scenes, %.1f MB", scenes.Size(), scenes.GetMemory() / (1024.0 * 1024.0));
+            parseShape::BufferPoolStats pool = scene->GetBufferPool()->GetStats();
+            ImGui::Text("Geometry: %.1f / %.1f MB in %zu buffers, %zu blocks, %.0f%% fragmented", pool.used / (1024.0 * 1024.0),
+                        pool.capacity / (1024.0 * 1024.0), pool.buffers, pool.blocks, pool.GetFragmentation() * 100.0f);
+            if (ImGui::Button("Defragment"))
+                scene->GetBufferPool()->Defragment();
+            parseShape::Animator &animator = scene->GetAnimator();
+            if (animator.GetTrackCount())
+            {
+                bool playing = animator.IsPlaying();
+                if (ImGui::Checkbox("Play", &playing))
+                    animator.SetPlaying(playing);
+                ImGui::SameLine();
+                ImGui::Text("%zu tracks, %.2f s", animator.GetTrackCount(), animator.GetTime());
+            }
+            const parseShape::LightGrid &lights = scene->GetLightGrid();
+            if (lights.GetLightCount())
+                ImGui::Text("Lights: %zu, %.1f per cell", lights.GetLightCount(), (float)lights.GetIndexCount() / lights.GetCellCount());
+            ImGui::Checkbox("Collisions", &checkCollisions);
+            if (checkCollisions)
+            {
+                parseShape::CollisionStats contacts = collisions.GetStats();
+                ImGui::SameLine();
+                ImGui::Text("%zu contacts, %zu candidates", contacts.contacts, contacts.candidates);
+            }
+        }
+        if(simulation && ImGui::Checkbox("Simulate", &simulate))
+        {
+            if(simulate)
+            {
+                std::vector<bool> meshes;
+                for (auto object : scene->GetObjects())
+                    meshes.push_back(dynamic_cast<parseShape::Mesh *>(object) != nullptr);
+                simulation->Start([meshes](parseShape::SceneSnapshot &state, float delta)
+                                  {
+                                      glm::quat spin = glm::angleAxis(delta, glm::vec3(0.0f, 1.0f, 0.0f));
+                                      for (size_t i = 0; i < state.objects.size(); i++)
+                                          if (meshes[i])
+                                              state.objects[i].rotation = spin * state.objects[i].rotation; });
+            }
+            else
+                simulation->Stop();
+        }
         ImGui::End();
         if (scene)
-            scene->Draw(); });
+        {
+            if (simulation)
+                simulation->Sync();
+            scene->GetAnimator().Update(delta);
+            scene->Update();
+            if (checkCollisions)
+            {
+                if (collisionScene != scene)
+                {
+                    collisions.Clear();
+                    for (auto mesh : scene->GetMeshes())
+                        collisions.Add(mesh);
+                    collisionScene = scene;
+                }
+                collisions.Update();
+            }
+            scene->Draw();
+        } });
 
     window.Run();
+    if (simulation)
+        delete simulation;
 
     return 0;
 }
\ No newline at end of file
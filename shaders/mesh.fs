@@ -7,11 +7,43 @@ in vec3 FragPos;
 uniform vec3 viewPos;
 uniform float brightness;
 uniform float ambientStrength;
+uniform mat4 view;
+uniform int lightCount;
+uniform samplerBuffer lightData;
+uniform usamplerBuffer lightCells;
+uniform usamplerBuffer lightIndices;
+uniform vec3 lightGrid;
+uniform vec2 lightTileScale;
+uniform vec3 lightDepth;
 
 out vec4 FragColor;
 
+vec3 PointLights()
+{
+    float depth = -(view * vec4(FragPos, 1.0)).z;
+    float slice = (lightDepth.z > 0.5 ? log(max(depth, 1e-4)) : depth) * lightDepth.x + lightDepth.y;
+    ivec3 cell = clamp(ivec3(vec3(gl_FragCoord.xy * lightTileScale, slice)), ivec3(0), ivec3(lightGrid) - 1);
+    int index = (cell.z * int(lightGrid.y) + cell.y) * int(lightGrid.x) + cell.x;
+    uvec2 range = texelFetch(lightCells, index).xy;
+    vec3 normal = normalize(Normal);
+    vec3 result = vec3(0.0);
+    for (uint i = 0u; i < range.y; i++)
+    {
+        int light = int(texelFetch(lightIndices, int(range.x + i)).x) * 2;
+        vec4 position = texelFetch(lightData, light);
+        vec3 color = texelFetch(lightData, light + 1).rgb;
+        vec3 direction = position.xyz - FragPos;
+        float reach = length(direction);
+        float falloff = clamp(1.0 - pow(reach / position.w, 2.0), 0.0, 1.0);
+        result += color * max(dot(normal, direction / max(reach, 1e-4)), 0.0) * falloff * falloff;
+    }
+    return result;
+}
+
 void main()
 {
     FragColor =  vec4(Color, 1.0) + (brightness + length(viewPos - FragPos) * -1.0);
     FragColor *= ambientStrength;
+    if (lightCount > 0)
+        FragColor.rgb += Color * PointLights();
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec3 aColor;
+in uint aObject;
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -10,13 +11,26 @@ out vec3 Color;
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
+uniform vec3 positionScale;
+uniform vec3 positionBias;
+uniform samplerBuffer objectTransforms;
+uniform bool useObjectTransforms;
 
 uniform float time;
 
+mat4 ObjectTransform()
+{
+    int base = int(aObject) * 4;
+    return mat4(texelFetch(objectTransforms, base), texelFetch(objectTransforms, base + 1),
+                texelFetch(objectTransforms, base + 2), texelFetch(objectTransforms, base + 3));
+}
+
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = normalize(mat3(transpose(inverse(model))) * aNormal);
+    mat4 object = useObjectTransforms ? ObjectTransform() : mat4(1.0);
+    vec3 position = vec3(object * vec4(aPos * positionScale + positionBias, 1.0));
+    FragPos = vec3(model * vec4(position, 1.0));
+    Normal = normalize(mat3(transpose(inverse(model * object))) * aNormal);
     Color = aColor;
     gl_Position = projection * view * model * vec4(FragPos, 1.0);
 }
\ No newline at end of file
@@ -1,9 +1,28 @@
+#include "core/Animation.h"
+#include "core/Bounds.h"
+#include "core/BVH.h"
+#include "core/BufferPool.h"
 #include "core/Camera.h"
+#include "core/Collision.h"
+#include "core/Frustum.h"
+#include "core/Light.h"
 #include "core/Mesh.h"
+#include "core/MeshBuilder.h"
+#include "core/MeshNormals.h"
+#include "core/MeshSimplify.h"
+#include "core/MeshWeld.h"
 #include "core/Object.h"
+#include "core/Occlusion.h"
+#include "core/Parallel.h"
 #include "core/Parser.h"
+#include "core/Primitive.h"
 #include "core/Scene.h"
+#include "core/SceneCache.h"
+#include "core/SceneState.h"
 #include "core/Shader.h"
+#include "core/StreamBuffer.h"
+#include "core/TransformStore.h"
 #include "core/Window.h"
 #include "core/GUI.h"
-#include "core/Vertex.h"
\ No newline at end of file
+#include "core/Vertex.h"
+#include "core/VertexFormat.h"
\ No newline at end of file
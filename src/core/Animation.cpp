@@ -0,0 +1,250 @@
+#ifndef ANIMATION_CPP
+#define ANIMATION_CPP
+
+#include "Animation.h"
+#include "Parallel.h"
+#include "Simd.h"
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+namespace parseShape
+{
+    namespace
+    {
+        // En : Largest turn around one axis between two rotation keys, normalized linear interpolation stays close to a
+        // constant speed below it.
+        // Tr : İki dönüş anahtarı arasında bir eksen etrafındaki en büyük dönüş, normalize doğrusal ara değerleme bunun
+        // altında sabit hıza yakın kalır.
+        const float maxTurn = 0.78539816f;
+        // En : Tracks a thread samples at once and tracks interpolated in one pass over the stack buffers.
+        // Tr : Bir thread'in tek seferde örneklediği izler ve yığın buffer'ları üzerinde tek geçişte ara değerlenen izler.
+        const size_t sampleBatch = 256, simdBatch = 64;
+
+        void PushRotation(AnimationTrack &track, float time, glm::vec3 angles)
+        {
+            glm::quat rotation(angles);
+            glm::vec4 value(rotation.x, rotation.y, rotation.z, rotation.w);
+            if (!track.values.empty() && glm::dot(track.values.back(), value) < 0.0f)
+                value = value * -1.0f;
+            track.times.push_back(time);
+            track.values.push_back(value);
+        }
+    }
+
+    void AnimationTrack::AddKey(float time, glm::vec3 value)
+    {
+        if (property != AnimationProperty::Rotation)
+        {
+            times.push_back(time);
+            values.push_back(glm::vec4(value, 0.0f));
+            return;
+        }
+        if (!times.empty())
+        {
+            glm::vec3 delta = value - lastAngles;
+            float largest = std::max(std::abs(delta.x), std::max(std::abs(delta.y), std::abs(delta.z)));
+            int steps = (int)std::ceil(largest / maxTurn);
+            float start = times.back();
+            for (int i = 1; i < steps; i++)
+            {
+                float t = (float)i / steps;
+                PushRotation(*this, start + (time - start) * t, lastAngles + delta * t);
+            }
+        }
+        PushRotation(*this, time, value);
+        lastAngles = value;
+    }
+    float AnimationTrack::GetDuration() const
+    {
+        return times.empty() ? 0.0f : times.back();
+    }
+
+#pragma region Tracks
+    void Animator::AddTrack(const AnimationTrack &track)
+    {
+        if (!track.target || track.times.empty() || track.times.size() != track.values.size())
+            return;
+        tracks.push_back(track);
+        cursors.push_back(0);
+    }
+    void Animator::RemoveTracks(Object *target)
+    {
+        for (size_t i = 0; i < tracks.size();)
+        {
+            if (tracks[i].target != target)
+            {
+                i++;
+                continue;
+            }
+            tracks.erase(tracks.begin() + i);
+            cursors.erase(cursors.begin() + i);
+        }
+    }
+    size_t Animator::GetTrackCount() const
+    {
+        return tracks.size();
+    }
+    float Animator::GetDuration() const
+    {
+        float duration = 0.0f;
+        for (auto &track : tracks)
+            duration = std::max(duration, track.GetDuration());
+        return duration;
+    }
+#pragma endregion
+#pragma region Evaluation
+    // En : Finds the keys around the time of every track in [begin, end) and interpolates them in batches. Positions and
+    // scales are interpolated linearly, rotations are interpolated linearly and normalized, which is selected per lane
+    // with a mask so all tracks share one loop.
+    // Tr : [begin, end) içindeki her izin zamanını çevreleyen anahtarları bulur ve onları gruplar halinde ara değerler.
+    // Konumlar ve ölçekler doğrusal, dönüşler doğrusal ara değerlenip normalize edilir, bu her şerit için bir maskeyle
+    // seçilir, böylece tüm izler tek döngüyü paylaşır.
+    void Animator::Sample(size_t begin, size_t end)
+    {
+        alignas(16) float from[4][simdBatch], to[4][simdBatch], weights[simdBatch], out[4][simdBatch];
+        alignas(16) uint32_t normalize[simdBatch];
+        for (size_t first = begin; first < end; first += simdBatch)
+        {
+            size_t count = std::min(simdBatch, end - first), padded = (count + 3) & ~(size_t)3;
+            for (size_t j = 0; j < count; j++)
+            {
+                const AnimationTrack &track = tracks[first + j];
+                const std::vector<float> &times = track.times;
+                size_t last = times.size() - 1;
+                float t = time, start = times.front(), length = times.back() - start;
+                if (track.loop && length > 0.0f)
+                {
+                    t = std::fmod(t - start, length);
+                    t = (t < 0.0f ? t + length : t) + start;
+                }
+                size_t a = 0, b = 0;
+                float weight = 0.0f;
+                if (t >= times.back())
+                    a = b = last;
+                else if (t > start)
+                {
+                    unsigned int &cursor = cursors[first + j];
+                    if (cursor >= last || times[cursor] > t || times[cursor + 1] <= t)
+                        cursor = std::upper_bound(times.begin(), times.end(), t) - times.begin() - 1;
+                    a = cursor;
+                    b = cursor + 1;
+                    weight = (t - times[a]) / (times[b] - times[a]);
+                }
+                for (int c = 0; c < 4; c++)
+                {
+                    from[c][j] = track.values[a][c];
+                    to[c][j] = track.values[b][c];
+                }
+                weights[j] = weight;
+                normalize[j] = track.property == AnimationProperty::Rotation ? UINT32_MAX : 0;
+            }
+            for (size_t j = count; j < padded; j++)
+            {
+                for (int c = 0; c < 4; c++)
+                    from[c][j] = to[c][j] = 0.0f;
+                weights[j] = 0.0f;
+                normalize[j] = 0;
+            }
+#ifdef PARSESHAPE_SSE2
+            const __m128 one = _mm_set1_ps(1.0f);
+            for (size_t j = 0; j < padded; j += 4)
+            {
+                __m128 weight = _mm_load_ps(weights + j), lengthSquared = _mm_setzero_ps(), value[4];
+                for (int c = 0; c < 4; c++)
+                {
+                    __m128 a = _mm_load_ps(from[c] + j);
+                    value[c] = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(to[c] + j), a), weight));
+                    lengthSquared = _mm_add_ps(lengthSquared, _mm_mul_ps(value[c], value[c]));
+                }
+                __m128 mask = _mm_castsi128_ps(_mm_load_si128((const __m128i *)(normalize + j)));
+                __m128 scale = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(one, _mm_sqrt_ps(lengthSquared))), _mm_andnot_ps(mask, one));
+                for (int c = 0; c < 4; c++)
+                    _mm_store_ps(out[c] + j, _mm_mul_ps(value[c], scale));
+            }
+#else
+            for (size_t j = 0; j < padded; j++)
+            {
+                float value[4], lengthSquared = 0.0f;
+                for (int c = 0; c < 4; c++)
+                {
+                    value[c] = from[c][j] + (to[c][j] - from[c][j]) * weights[j];
+                    lengthSquared += value[c] * value[c];
+                }
+                float scale = normalize[j] ? 1.0f / std::sqrt(lengthSquared) : 1.0f;
+                for (int c = 0; c < 4; c++)
+                    out[c][j] = value[c] * scale;
+            }
+#endif
+            for (size_t j = 0; j < count; j++)
+                results[first + j] = glm::vec4(out[0][j], out[1][j], out[2][j], out[3][j]);
+        }
+    }
+    void Animator::Evaluate()
+    {
+        results.resize(tracks.size());
+        ParallelFor(tracks.size(), [this](size_t begin, size_t end)
+                    { Sample(begin, end); }, sampleBatch);
+        // En : Objects are written on the calling thread, setting a transform marks the children of the object.
+        // Tr : Nesneler çağıran thread'de yazılır, bir dönüşümü ayarlamak nesnenin çocuklarını işaretler.
+        for (size_t i = 0; i < tracks.size(); i++)
+        {
+            Object *target = tracks[i].target;
+            const glm::vec4 &value = results[i];
+            switch (tracks[i].property)
+            {
+            case AnimationProperty::Position:
+                if (target->GetPosition() != glm::vec3(value))
+                    target->SetPosition(glm::vec3(value));
+                break;
+            case AnimationProperty::Rotation:
+            {
+                glm::quat rotation(value.w, value.x, value.y, value.z);
+                if (target->GetRotation() != rotation)
+                    target->SetRotation(rotation);
+                break;
+            }
+            case AnimationProperty::Scale:
+                if (target->GetScale() != glm::vec3(value))
+                    target->SetScale(glm::vec3(value));
+                break;
+            }
+        }
+    }
+    void Animator::Update(float delta)
+    {
+        if (!playing || tracks.empty())
+            return;
+        time += delta * speed;
+        Evaluate();
+    }
+#pragma endregion
+#pragma region Playback
+    void Animator::SetTime(float time)
+    {
+        this->time = time;
+    }
+    float Animator::GetTime() const
+    {
+        return time;
+    }
+    void Animator::SetSpeed(float speed)
+    {
+        this->speed = speed;
+    }
+    float Animator::GetSpeed() const
+    {
+        return speed;
+    }
+    void Animator::SetPlaying(bool playing)
+    {
+        this->playing = playing;
+    }
+    bool Animator::IsPlaying() const
+    {
+        return playing;
+    }
+#pragma endregion
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include "Object.h"
+
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace parseShape
+{
+    enum class AnimationProperty
+    {
+        Position,
+        Rotation,
+        Scale
+    };
+
+    // En : Keyframes of one property of one object, values between keys are interpolated linearly.
+    // Rotations are stored as quaternions, each in the hemisphere of the previous key.
+    // Tr : Bir nesnenin bir özelliğinin anahtar kareleri, anahtarlar arasındaki değerler doğrusal olarak ara değerlenir.
+    // Dönüşler kuaterniyon olarak saklanır, her biri önceki anahtarın yarıküresinde.
+    struct AnimationTrack
+    {
+        Object *target = nullptr;
+        AnimationProperty property = AnimationProperty::Position;
+        // En : After the last key a looping track starts again from the first one, otherwise it holds the last value.
+        // Tr : Son anahtardan sonra döngülü bir iz ilkinden yeniden başlar, aksi halde son değeri korur.
+        bool loop = true;
+        std::vector<float> times;
+        // En : xyz for positions and scales, xyzw of the quaternion for rotations.
+        // Tr : Konumlar ve ölçekler için xyz, dönüşler için kuaterniyonun xyzw'si.
+        std::vector<glm::vec4> values;
+        // En : Euler angles of the last rotation key, used to split large turns.
+        // Tr : Son dönüş anahtarının Euler açıları, büyük dönüşleri bölmek için kullanılır.
+        glm::vec3 lastAngles = glm::vec3(0.0f);
+
+        // En : Appends a key, `time` must not be earlier than the last key. Rotations are Euler angles in radians,
+        // turns of more than an eighth between two keys get extra keys, so a full turn between two keys is kept.
+        // Tr : Bir anahtar ekler, `time` son anahtardan önce olmamalıdır. Dönüşler radyan cinsinden Euler açılarıdır,
+        // iki anahtar arasında sekizde birden fazla dönüşler ek anahtar alır, böylece iki anahtar arasındaki tam tur korunur.
+        void AddKey(float time, glm::vec3 value);
+        float GetDuration() const;
+    };
+
+    // En : Plays the animation tracks of a scene. Every frame the keys of all tracks are found first, then the values
+    // are interpolated four tracks at a time in SIMD registers and written into the objects. Objects only receive
+    // new transforms, so draws with object transforms are updated without writing vertices.
+    // Tr : Bir sahnenin animasyon izlerini oynatır. Her karede önce tüm izlerin anahtarları bulunur, ardından değerler
+    // SIMD yazmaçlarında dörder iz halinde ara değerlenir ve nesnelere yazılır. Nesneler yalnızca yeni dönüşümler alır,
+    // böylece nesne dönüşümlü çizimler vertex yazmadan güncellenir.
+    class Animator
+    {
+    private:
+        std::vector<AnimationTrack> tracks;
+        // En : Index of the key before the sampled time of every track, the next frame usually starts its search there.
+        // Tr : Her izin örneklenen zamandan önceki anahtarının indisi, sonraki kare aramasına genellikle oradan başlar.
+        std::vector<unsigned int> cursors;
+        std::vector<glm::vec4> results;
+        float time = 0.0f, speed = 1.0f;
+        bool playing = true;
+
+        void Sample(size_t begin, size_t end);
+
+    public:
+        // En : Adds a track with at least one key.
+        // Tr : En az bir anahtarı olan bir iz ekler.
+        void AddTrack(const AnimationTrack &track);
+        // En : Removes the tracks of the object, called before it is deleted.
+        // Tr : Nesnenin izlerini siler, nesne silinmeden önce çağrılır.
+        void RemoveTracks(Object *target);
+        size_t GetTrackCount() const;
+        // En : Returns the time of the last key of all tracks.
+        // Tr : Tüm izlerin son anahtarının zamanını döndürür.
+        float GetDuration() const;
+
+        // En : Advances the time by `delta` times the speed while playing and applies the tracks.
+        // Tr : Oynarken zamanı `delta` çarpı hız kadar ilerletir ve izleri uygular.
+        void Update(float delta);
+        // En : Samples every track at the current time and writes the values that changed into the objects.
+        // Tr : Her izi geçerli zamanda örnekler ve değişen değerleri nesnelere yazar.
+        void Evaluate();
+        void SetTime(float time);
+        float GetTime() const;
+        void SetSpeed(float speed);
+        float GetSpeed() const;
+        void SetPlaying(bool playing);
+        bool IsPlaying() const;
+    };
+}
+#endif
\ No newline at end of file
@@ -19,7 +19,8 @@ namespace parseShape
         MAT2,
         MAT3,
         MAT4,
-        SAMPLER2D
+        SAMPLER2D,
+        SAMPLERBUFFER
     };
 
     typedef std::map<std::string, AttributeType> AttributeTypeName;
@@ -36,6 +37,7 @@ namespace parseShape
         {"mat2", MAT2},
         {"mat3", MAT3},
         {"mat4", MAT4},
-        {"sampler2D", SAMPLER2D}};
+        {"sampler2D", SAMPLER2D},
+        {"samplerBuffer", SAMPLERBUFFER}};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,701 @@
+#ifndef BVH_CPP
+#define BVH_CPP
+
+#include "BVH.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace parseShape
+{
+    namespace
+    {
+        const int binCount = 16;
+        const unsigned int maxLeafSize = 8;
+        // En : Nodes larger than this are split with parallel passes, smaller ones become subtrees built on one thread.
+        // Tr : Bundan büyük düğümler paralel geçişlerle bölünür, küçükler tek thread'de oluşturulan alt ağaçlar olur.
+        const unsigned int subtreeSize = 32768;
+        const size_t passBatch = 4096;
+
+        // En : Inline versions of AABB::Expand for the build loops.
+        // Tr : Oluşturma döngüleri için AABB::Expand'in satır içi halleri.
+        inline void Grow(AABB &box, glm::vec3 point)
+        {
+            box.min = glm::min(box.min, point);
+            box.max = glm::max(box.max, point);
+        }
+        inline void Grow(AABB &box, const AABB &other)
+        {
+            box.min = glm::min(box.min, other.min);
+            box.max = glm::max(box.max, other.max);
+        }
+
+        struct Bin
+        {
+            AABB bounds;
+            unsigned int count = 0;
+        };
+        // En : Bins of the three axes, small nodes use fewer bins than there are room for.
+        // Tr : Üç eksenin grupları, küçük düğümler yer olandan daha az grup kullanır.
+        struct Bins
+        {
+            Bin bins[3][binCount];
+            int count = binCount;
+
+            void Reset(int count)
+            {
+                this->count = count;
+                for (int axis = 0; axis < 3; axis++)
+                    for (int i = 0; i < count; i++)
+                        bins[axis][i] = Bin();
+            }
+            void Merge(const Bins &other)
+            {
+                for (int axis = 0; axis < 3; axis++)
+                    for (int i = 0; i < count; i++)
+                    {
+                        Grow(bins[axis][i].bounds, other.bins[axis][i].bounds);
+                        bins[axis][i].count += other.bins[axis][i].count;
+                    }
+            }
+        };
+        struct Split
+        {
+            int axis = -1, bin = 0;
+        };
+        struct BuildTask
+        {
+            unsigned int node, begin, end;
+        };
+        // En : Build time copy of a triangle, kept together so the passes over a node read memory in order.
+        // Tr : Bir üçgenin oluşturma anındaki kopyası, bir düğüm üzerindeki geçişler belleği sırayla okusun diye bir arada tutulur.
+        struct BuildPrimitive
+        {
+            AABB box;
+            glm::vec3 centroid;
+            unsigned int index;
+        };
+
+        float Area(const AABB &box)
+        {
+            if (!box.IsValid())
+                return 0.0f;
+            glm::vec3 size = box.max - box.min;
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+        bool Overlaps(const AABB &a, const AABB &b)
+        {
+            return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+                   a.min.y <= b.max.y && a.max.y >= b.min.y &&
+                   a.min.z <= b.max.z && a.max.z >= b.min.z;
+        }
+        AABB TriangleBounds(const glm::vec3 *corner)
+        {
+            AABB box;
+            box.min = glm::min(glm::min(corner[0], corner[1]), corner[2]);
+            box.max = glm::max(glm::max(corner[0], corner[1]), corner[2]);
+            return box;
+        }
+
+        // En : Top down binned SAH builder over the triangle boxes, it reorders `primitives` in place.
+        // Tr : Üçgen kutuları üzerinde yukarıdan aşağıya gruplanmış SAH oluşturucu, `primitives`'i yerinde yeniden sıralar.
+        class Builder
+        {
+        private:
+            std::vector<BuildPrimitive> &primitives;
+
+            void Bounds(unsigned int begin, unsigned int end, AABB &bounds, AABB &centroidBounds) const
+            {
+                for (unsigned int i = begin; i < end; i++)
+                {
+                    Grow(bounds, primitives[i].box);
+                    Grow(centroidBounds, primitives[i].centroid);
+                }
+            }
+            // En : Scales a centroid into bin units, axes without extent get a zero scale and put everything in the first bin.
+            // Tr : Bir merkezi grup birimine ölçekler, boyutu olmayan eksenler sıfır ölçek alır ve her şeyi ilk gruba koyar.
+            static int BinsFor(unsigned int count)
+            {
+                return std::min<unsigned int>(binCount, std::max(count, 2u));
+            }
+            static glm::vec3 BinScale(const AABB &centroidBounds, int count)
+            {
+                glm::vec3 extent = centroidBounds.max - centroidBounds.min, scale(0.0f);
+                for (int axis = 0; axis < 3; axis++)
+                    if (extent[axis] > 0.0f)
+                        scale[axis] = count / extent[axis];
+                return scale;
+            }
+            static int BinOf(float centroid, float min, float scale, int count)
+            {
+                int bin = (int)((centroid - min) * scale);
+                return std::min(std::max(bin, 0), count - 1);
+            }
+            void Fill(unsigned int begin, unsigned int end, const AABB &centroidBounds, Bins &bins) const
+            {
+                glm::vec3 scale = BinScale(centroidBounds, bins.count);
+                for (unsigned int i = begin; i < end; i++)
+                {
+                    const BuildPrimitive &primitive = primitives[i];
+                    for (int axis = 0; axis < 3; axis++)
+                    {
+                        Bin &bin = bins.bins[axis][BinOf(primitive.centroid[axis], centroidBounds.min[axis], scale[axis], bins.count)];
+                        Grow(bin.bounds, primitive.box);
+                        bin.count++;
+                    }
+                }
+            }
+            // En : Picks the cheapest plane between the bins, returns an invalid split if a leaf is cheaper.
+            // Tr : Gruplar arasındaki en ucuz düzlemi seçer, bir yaprak daha ucuzsa geçersiz bir bölme döndürür.
+            static Split FindSplit(const Bins &bins, const AABB &bounds, unsigned int count)
+            {
+                Split split;
+                float best = FLT_MAX;
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    float rightCost[binCount];
+                    AABB box;
+                    unsigned int right = 0;
+                    for (int i = bins.count - 1; i > 0; i--)
+                    {
+                        Grow(box, bins.bins[axis][i].bounds);
+                        right += bins.bins[axis][i].count;
+                        rightCost[i] = Area(box) * right;
+                    }
+                    box = AABB();
+                    unsigned int left = 0;
+                    for (int i = 0; i < bins.count - 1; i++)
+                    {
+                        Grow(box, bins.bins[axis][i].bounds);
+                        left += bins.bins[axis][i].count;
+                        if (!left || left == count)
+                            continue;
+                        float cost = Area(box) * left + rightCost[i + 1];
+                        if (cost < best)
+                        {
+                            best = cost;
+                            split.axis = axis;
+                            split.bin = i + 1;
+                        }
+                    }
+                }
+                // En : One traversal step costs as much as one triangle test.
+                // Tr : Bir gezinme adımı bir üçgen testi kadar maliyetlidir.
+                float area = Area(bounds);
+                if (split.axis >= 0 && count <= maxLeafSize && (area <= 0.0f || 1.0f + best / area >= count))
+                    split.axis = -1;
+                return split;
+            }
+            unsigned int Partition(unsigned int begin, unsigned int end, const Split &split, const AABB &centroidBounds)
+            {
+                // En : Without a usable plane the triangles are split in half, so large clusters of equal centroids still end in small leaves.
+                // Tr : Kullanılabilir bir düzlem yoksa üçgenler ikiye bölünür, böylece aynı merkezli büyük kümeler de küçük yapraklarda biter.
+                if (split.axis < 0)
+                    return begin + (end - begin) / 2;
+                int count = BinsFor(end - begin);
+                float min = centroidBounds.min[split.axis], scale = BinScale(centroidBounds, count)[split.axis];
+                auto middle = std::partition(primitives.begin() + begin, primitives.begin() + end, [&](const BuildPrimitive &primitive)
+                                             { return BinOf(primitive.centroid[split.axis], min, scale, count) < split.bin; });
+                return middle - primitives.begin();
+            }
+            bool IsLeaf(const Split &split, unsigned int count) const
+            {
+                return count <= 1 || (split.axis < 0 && count <= maxLeafSize);
+            }
+
+        public:
+            Builder(std::vector<BuildPrimitive> &primitives) : primitives(primitives) {}
+
+            // En : Splits a large node with parallel passes, returns false if the node became a leaf.
+            // Tr : Büyük bir düğümü paralel geçişlerle böler, düğüm yaprak olduysa false döndürür.
+            bool SplitParallel(BVHNode &node, unsigned int begin, unsigned int end, unsigned int &middle)
+            {
+                size_t slots = (end - begin + passBatch - 1) / passBatch;
+                std::vector<AABB> bounds(slots), centroidBounds(slots);
+                ParallelFor(end - begin, [&](size_t first, size_t last)
+                            { Bounds(begin + first, begin + last, bounds[first / passBatch], centroidBounds[first / passBatch]); }, passBatch);
+                AABB nodeBounds, nodeCentroids;
+                for (size_t i = 0; i < slots; i++)
+                {
+                    Grow(nodeBounds, bounds[i]);
+                    Grow(nodeCentroids, centroidBounds[i]);
+                }
+                std::vector<Bins> bins(slots);
+                for (Bins &slot : bins)
+                    slot.Reset(BinsFor(end - begin));
+                ParallelFor(end - begin, [&](size_t first, size_t last)
+                            { Fill(begin + first, begin + last, nodeCentroids, bins[first / passBatch]); }, passBatch);
+                for (size_t i = 1; i < slots; i++)
+                    bins[0].Merge(bins[i]);
+
+                node.bounds = nodeBounds;
+                Split split = FindSplit(bins[0], nodeBounds, end - begin);
+                if (IsLeaf(split, end - begin))
+                    return false;
+                middle = Partition(begin, end, split, nodeCentroids);
+                return true;
+            }
+            // En : Builds the subtree of [begin, end) into `nodes` at `index`, children are appended in pairs.
+            // `bins` is scratch space, it is free again once the split is found.
+            // Tr : [begin, end) alt ağacını `nodes` içinde `index`'e oluşturur, çocuklar çiftler halinde eklenir.
+            // `bins` geçici alandır, bölme bulunduktan sonra yeniden boştur.
+            void BuildSubtree(std::vector<BVHNode> &nodes, Bins &bins, unsigned int index, unsigned int begin, unsigned int end)
+            {
+                AABB bounds, centroidBounds;
+                Bounds(begin, end, bounds, centroidBounds);
+                bins.Reset(BinsFor(end - begin));
+                Fill(begin, end, centroidBounds, bins);
+                Split split = FindSplit(bins, bounds, end - begin);
+                nodes[index].bounds = bounds;
+                if (IsLeaf(split, end - begin))
+                {
+                    nodes[index].first = begin;
+                    nodes[index].count = end - begin;
+                    return;
+                }
+                unsigned int middle = Partition(begin, end, split, centroidBounds);
+                unsigned int children = nodes.size();
+                nodes.resize(children + 2);
+                nodes[index].first = children;
+                nodes[index].count = 0;
+                BuildSubtree(nodes, bins, children, begin, middle);
+                BuildSubtree(nodes, bins, children + 1, middle, end);
+            }
+        };
+
+        // En : Closest point on a triangle, from Real-Time Collision Detection 5.1.5.
+        // Tr : Bir üçgen üzerindeki en yakın nokta, Real-Time Collision Detection 5.1.5'ten.
+        glm::vec3 ClosestPoint(glm::vec3 p, glm::vec3 a, glm::vec3 b, glm::vec3 c, glm::vec2 &barycentric)
+        {
+            glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+            float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+            if (d1 <= 0.0f && d2 <= 0.0f)
+            {
+                barycentric = glm::vec2(0.0f, 0.0f);
+                return a;
+            }
+            glm::vec3 bp = p - b;
+            float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+            if (d3 >= 0.0f && d4 <= d3)
+            {
+                barycentric = glm::vec2(1.0f, 0.0f);
+                return b;
+            }
+            float vc = d1 * d4 - d3 * d2;
+            if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+            {
+                float v = d1 / (d1 - d3);
+                barycentric = glm::vec2(v, 0.0f);
+                return a + ab * v;
+            }
+            glm::vec3 cp = p - c;
+            float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+            if (d6 >= 0.0f && d5 <= d6)
+            {
+                barycentric = glm::vec2(0.0f, 1.0f);
+                return c;
+            }
+            float vb = d5 * d2 - d1 * d6;
+            if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+            {
+                float w = d2 / (d2 - d6);
+                barycentric = glm::vec2(0.0f, w);
+                return a + ac * w;
+            }
+            float va = d3 * d6 - d5 * d4;
+            if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+            {
+                float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+                barycentric = glm::vec2(1.0f - w, w);
+                return b + (c - b) * w;
+            }
+            float denominator = 1.0f / (va + vb + vc);
+            float v = vb * denominator, w = vc * denominator;
+            barycentric = glm::vec2(v, w);
+            return a + ab * v + ac * w;
+        }
+        // En : Returns the entry distance of the ray into the box, or FLT_MAX if it misses it within `maxDistance`.
+        // Tr : Işının kutuya giriş uzaklığını döndürür, `maxDistance` içinde ıskalarsa FLT_MAX döner.
+        float IntersectBox(const AABB &box, glm::vec3 origin, glm::vec3 inverseDirection, float maxDistance)
+        {
+            glm::vec3 t0 = (box.min - origin) * inverseDirection, t1 = (box.max - origin) * inverseDirection;
+            glm::vec3 near = glm::min(t0, t1), far = glm::max(t0, t1);
+            float enter = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+            float exit = std::min(std::min(far.x, far.y), std::min(far.z, maxDistance));
+            return enter <= exit ? enter : FLT_MAX;
+        }
+        float DistanceSquared(const AABB &box, glm::vec3 point)
+        {
+            glm::vec3 outside = glm::max(glm::max(box.min - point, point - box.max), glm::vec3(0.0f));
+            return glm::dot(outside, outside);
+        }
+    }
+
+    bool BVHHit::IsValid() const
+    {
+        return distance != FLT_MAX;
+    }
+
+    // En : Writes the corners of the tree order triangles [begin, end) with the transforms of their meshes.
+    // Tr : Ağaç sırasındaki [begin, end) üçgenlerinin köşelerini meshlerinin dönüşümleriyle yazar.
+    void BVH::ReadTriangles(const std::vector<glm::mat4> &transforms, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const TriangleRef &reference = references[i];
+            const glm::mat4 &transform = transforms[meshIndices[i]];
+            const std::vector<float> &vertices = reference.mesh->GetVertexData();
+            const std::vector<unsigned int> &indices = reference.mesh->GetIndexData();
+            size_t stride = reference.mesh->GetVertexSize();
+            for (int corner = 0; corner < 3; corner++)
+            {
+                const float *position = &vertices[indices[reference.triangle * 3 + corner] * stride];
+                corners[i * 3 + corner] = glm::vec3(transform * glm::vec4(position[0], position[1], position[2], 1.0f));
+            }
+        }
+    }
+    std::vector<glm::mat4> BVH::GetTransforms() const
+    {
+        std::vector<glm::mat4> transforms(meshes.size(), glm::mat4(1.0f));
+        if (!local)
+            for (size_t m = 0; m < meshes.size(); m++)
+                transforms[m] = meshes[m]->GetTransform();
+        return transforms;
+    }
+    void BVH::RefitNodes()
+    {
+        ParallelFor(nodes.size(), [&](size_t begin, size_t end)
+                    {
+            for (size_t i = begin; i < end; i++)
+            {
+                BVHNode &node = nodes[i];
+                if (!node.count)
+                    continue;
+                node.bounds = AABB();
+                for (unsigned int t = node.first; t < node.first + node.count; t++)
+                    Grow(node.bounds, TriangleBounds(&corners[t * 3]));
+            } }, passBatch);
+        // En : Children are always stored after their parent, so a backward pass sees them first.
+        // Tr : Çocuklar her zaman ebeveynlerinden sonra saklanır, bu yüzden geriye doğru bir geçiş onları önce görür.
+        for (size_t i = nodes.size(); i-- > 0;)
+        {
+            BVHNode &node = nodes[i];
+            if (node.count)
+                continue;
+            node.bounds = nodes[node.first].bounds;
+            Grow(node.bounds, nodes[node.first + 1].bounds);
+        }
+    }
+
+    void BVH::Build(const std::vector<Mesh *> &meshes, bool local)
+    {
+        Clear();
+        this->local = local;
+        std::vector<size_t> offsets;
+        size_t triangleCount = 0;
+        for (Mesh *mesh : meshes)
+        {
+            if (mesh->GetVertexSize() < 3)
+                continue;
+            this->meshes.push_back(mesh);
+            offsets.push_back(triangleCount);
+            triangleCount += mesh->GetIndexData().size() / 3;
+        }
+        if (!triangleCount)
+            return;
+
+        references.resize(triangleCount);
+        meshIndices.resize(triangleCount);
+        ParallelFor(this->meshes.size(), [&](size_t begin, size_t end)
+                    {
+            for (size_t m = begin; m < end; m++)
+            {
+                size_t count = this->meshes[m]->GetIndexData().size() / 3;
+                for (size_t t = 0; t < count; t++)
+                {
+                    references[offsets[m] + t] = {this->meshes[m], (unsigned int)t};
+                    meshIndices[offsets[m] + t] = m;
+                }
+            } }, 1);
+        corners.resize(triangleCount * 3);
+        std::vector<glm::mat4> transforms = GetTransforms();
+        ParallelFor(triangleCount, [&](size_t begin, size_t end)
+                    { ReadTriangles(transforms, begin, end); }, passBatch);
+
+        std::vector<BuildPrimitive> primitives(triangleCount);
+        ParallelFor(triangleCount, [&](size_t begin, size_t end)
+                    {
+            for (size_t i = begin; i < end; i++)
+            {
+                primitives[i].box = TriangleBounds(&corners[i * 3]);
+                primitives[i].centroid = (primitives[i].box.min + primitives[i].box.max) * 0.5f;
+                primitives[i].index = i;
+            } }, passBatch);
+
+        // En : Large nodes are split one at a time with parallel passes until every remaining node is a small subtree.
+        // Tr : Büyük düğümler kalan her düğüm küçük bir alt ağaç olana kadar paralel geçişlerle tek tek bölünür.
+        Builder builder(primitives);
+        nodes.resize(1);
+        std::vector<BuildTask> tasks = {{0, 0, (unsigned int)triangleCount}}, subtrees;
+        while (!tasks.empty())
+        {
+            BuildTask task = tasks.back();
+            tasks.pop_back();
+            if (task.end - task.begin <= subtreeSize || GetThreadCount() == 1)
+            {
+                subtrees.push_back(task);
+                continue;
+            }
+            unsigned int middle;
+            if (!builder.SplitParallel(nodes[task.node], task.begin, task.end, middle))
+            {
+                nodes[task.node].first = task.begin;
+                nodes[task.node].count = task.end - task.begin;
+                continue;
+            }
+            unsigned int children = nodes.size();
+            nodes.resize(children + 2);
+            nodes[task.node].first = children;
+            nodes[task.node].count = 0;
+            tasks.push_back({children, task.begin, middle});
+            tasks.push_back({children + 1, middle, task.end});
+        }
+        std::vector<std::vector<BVHNode>> subtreeNodes(subtrees.size());
+        ParallelFor(subtrees.size(), [&](size_t begin, size_t end)
+                    {
+            for (size_t i = begin; i < end; i++)
+            {
+                Bins bins;
+                subtreeNodes[i].resize(1);
+                builder.BuildSubtree(subtreeNodes[i], bins, 0, subtrees[i].begin, subtrees[i].end);
+            } }, 1);
+        // En : The root of a subtree takes the place of its task node, the rest is appended and its child links are moved.
+        // Tr : Bir alt ağacın kökü görev düğümünün yerini alır, kalanı eklenir ve çocuk bağlantıları kaydırılır.
+        for (size_t i = 0; i < subtrees.size(); i++)
+        {
+            const std::vector<BVHNode> &local = subtreeNodes[i];
+            unsigned int base = nodes.size() - 1;
+            for (size_t k = 0; k < local.size(); k++)
+            {
+                BVHNode node = local[k];
+                if (!node.count)
+                    node.first += base;
+                if (k == 0)
+                    nodes[subtrees[i].node] = node;
+                else
+                    nodes.push_back(node);
+            }
+        }
+
+        std::vector<TriangleRef> orderedReferences(triangleCount);
+        std::vector<unsigned int> orderedMeshes(triangleCount);
+        std::vector<glm::vec3> orderedCorners(triangleCount * 3);
+        ParallelFor(triangleCount, [&](size_t begin, size_t end)
+                    {
+            for (size_t i = begin; i < end; i++)
+            {
+                unsigned int index = primitives[i].index;
+                orderedReferences[i] = references[index];
+                orderedMeshes[i] = meshIndices[index];
+                for (int corner = 0; corner < 3; corner++)
+                    orderedCorners[i * 3 + corner] = corners[index * 3 + corner];
+            } }, passBatch);
+        references.swap(orderedReferences);
+        meshIndices.swap(orderedMeshes);
+        corners.swap(orderedCorners);
+    }
+    bool BVH::Refit()
+    {
+        std::vector<size_t> counts(meshes.size(), 0);
+        for (unsigned int m : meshIndices)
+            counts[m]++;
+        for (size_t m = 0; m < meshes.size(); m++)
+            if (meshes[m]->GetIndexData().size() / 3 != counts[m])
+                return false;
+        if (nodes.empty())
+            return true;
+        std::vector<glm::mat4> transforms = GetTransforms();
+        ParallelFor(references.size(), [&](size_t begin, size_t end)
+                    { ReadTriangles(transforms, begin, end); }, passBatch);
+        RefitNodes();
+        return true;
+    }
+    void BVH::Clear()
+    {
+        nodes.clear();
+        meshes.clear();
+        meshIndices.clear();
+        references.clear();
+        corners.clear();
+    }
+
+    BVHHit BVH::Intersect(const Ray &ray, float maxDistance) const
+    {
+        BVHHit hit;
+        if (nodes.empty())
+            return hit;
+        glm::vec3 inverseDirection = 1.0f / ray.direction;
+        float closest = maxDistance;
+        // En : Nodes are kept with their entry distance, so the ones behind a closer hit are skipped.
+        // Tr : Düğümler giriş uzaklıklarıyla tutulur, böylece daha yakın bir çarpmanın arkasında kalanlar atlanır.
+        std::vector<std::pair<float, unsigned int>> stack;
+        stack.reserve(64);
+        float entry = IntersectBox(nodes[0].bounds, ray.origin, inverseDirection, closest);
+        if (entry != FLT_MAX)
+            stack.push_back({entry, 0});
+        while (!stack.empty())
+        {
+            auto top = stack.back();
+            stack.pop_back();
+            if (top.first > closest)
+                continue;
+            const BVHNode &node = nodes[top.second];
+            if (node.count)
+            {
+                for (unsigned int t = node.first; t < node.first + node.count; t++)
+                {
+                    // En : Möller-Trumbore, both faces are accepted.
+                    // Tr : Möller-Trumbore, iki yüz de kabul edilir.
+                    const glm::vec3 *corner = &corners[t * 3];
+                    glm::vec3 edge1 = corner[1] - corner[0], edge2 = corner[2] - corner[0];
+                    glm::vec3 p = glm::cross(ray.direction, edge2);
+                    float determinant = glm::dot(edge1, p);
+                    if (std::fabs(determinant) < 1e-12f)
+                        continue;
+                    float inverse = 1.0f / determinant;
+                    glm::vec3 s = ray.origin - corner[0];
+                    float u = glm::dot(s, p) * inverse;
+                    if (u < 0.0f || u > 1.0f)
+                        continue;
+                    glm::vec3 q = glm::cross(s, edge1);
+                    float v = glm::dot(ray.direction, q) * inverse;
+                    if (v < 0.0f || u + v > 1.0f)
+                        continue;
+                    float distance = glm::dot(edge2, q) * inverse;
+                    if (distance < 0.0f || distance >= closest)
+                        continue;
+                    closest = distance;
+                    hit.triangle = references[t];
+                    hit.distance = distance;
+                    hit.barycentric = glm::vec2(u, v);
+                    hit.point = ray.origin + ray.direction * distance;
+                }
+                continue;
+            }
+            // En : The nearer child is pushed last so it is visited first and shortens the ray for the other.
+            // Tr : Yakın çocuk en son eklenir, böylece önce ziyaret edilir ve diğeri için ışını kısaltır.
+            float left = IntersectBox(nodes[node.first].bounds, ray.origin, inverseDirection, closest);
+            float right = IntersectBox(nodes[node.first + 1].bounds, ray.origin, inverseDirection, closest);
+            unsigned int near = node.first, far = node.first + 1;
+            if (right < left)
+            {
+                std::swap(near, far);
+                std::swap(left, right);
+            }
+            if (right != FLT_MAX)
+                stack.push_back({right, far});
+            if (left != FLT_MAX)
+                stack.push_back({left, near});
+        }
+        return hit;
+    }
+    void BVH::Query(const AABB &box, std::vector<TriangleRef> &result) const
+    {
+        if (nodes.empty() || !box.IsValid())
+            return;
+        std::vector<unsigned int> stack = {0};
+        while (!stack.empty())
+        {
+            const BVHNode &node = nodes[stack.back()];
+            stack.pop_back();
+            if (!Overlaps(node.bounds, box))
+                continue;
+            if (!node.count)
+            {
+                stack.push_back(node.first);
+                stack.push_back(node.first + 1);
+                continue;
+            }
+            for (unsigned int t = node.first; t < node.first + node.count; t++)
+                if (Overlaps(TriangleBounds(&corners[t * 3]), box))
+                    result.push_back(references[t]);
+        }
+    }
+    BVHHit BVH::Nearest(glm::vec3 point, float maxDistance) const
+    {
+        BVHHit hit;
+        if (nodes.empty())
+            return hit;
+        float closest = maxDistance == FLT_MAX ? FLT_MAX : maxDistance * maxDistance;
+        std::vector<std::pair<float, unsigned int>> stack = {{DistanceSquared(nodes[0].bounds, point), 0}};
+        while (!stack.empty())
+        {
+            auto entry = stack.back();
+            stack.pop_back();
+            if (entry.first > closest)
+                continue;
+            const BVHNode &node = nodes[entry.second];
+            if (node.count)
+            {
+                for (unsigned int t = node.first; t < node.first + node.count; t++)
+                {
+                    const glm::vec3 *corner = &corners[t * 3];
+                    glm::vec2 barycentric;
+                    glm::vec3 candidate = ClosestPoint(point, corner[0], corner[1], corner[2], barycentric);
+                    glm::vec3 offset = candidate - point;
+                    float distance = glm::dot(offset, offset);
+                    if (distance > closest)
+                        continue;
+                    closest = distance;
+                    hit.triangle = references[t];
+                    hit.point = candidate;
+                    hit.barycentric = barycentric;
+                    hit.distance = distance;
+                }
+                continue;
+            }
+            float left = DistanceSquared(nodes[node.first].bounds, point);
+            float right = DistanceSquared(nodes[node.first + 1].bounds, point);
+            if (left <= right)
+            {
+                stack.push_back({right, node.first + 1});
+                stack.push_back({left, node.first});
+            }
+            else
+            {
+                stack.push_back({left, node.first});
+                stack.push_back({right, node.first + 1});
+            }
+        }
+        if (hit.IsValid())
+            hit.distance = std::sqrt(hit.distance);
+        return hit;
+    }
+
+    AABB BVH::GetBounds() const
+    {
+        return nodes.empty() ? AABB() : nodes[0].bounds;
+    }
+    size_t BVH::GetNodeCount() const
+    {
+        return nodes.size();
+    }
+    size_t BVH::GetTriangleCount() const
+    {
+        return references.size();
+    }
+    const std::vector<BVHNode> &BVH::GetNodes() const
+    {
+        return nodes;
+    }
+    TriangleRef BVH::GetTriangle(unsigned int index) const
+    {
+        return references[index];
+    }
+    const glm::vec3 *BVH::GetCorners(unsigned int index) const
+    {
+        return &corners[index * 3];
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include "Mesh.h"
+#include "Bounds.h"
+
+#include <vector>
+#include <cfloat>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+namespace parseShape
+{
+    // En : A triangle of a mesh, `triangle` is the index of its first index divided by three.
+    // Tr : Bir meshin üçgeni, `triangle` ilk index'inin üçe bölümüdür.
+    struct TriangleRef
+    {
+        Mesh *mesh = nullptr;
+        unsigned int triangle = 0;
+    };
+
+    // En : Result of a ray or nearest point query, `distance` is FLT_MAX if nothing was found.
+    // `barycentric` holds the weights of the second and third corners at the point.
+    // Tr : Bir ışın ya da en yakın nokta sorgusunun sonucu, hiçbir şey bulunmadıysa `distance` FLT_MAX'tır.
+    // `barycentric` noktadaki ikinci ve üçüncü köşenin ağırlıklarını tutar.
+    struct BVHHit
+    {
+        TriangleRef triangle;
+        float distance = FLT_MAX;
+        glm::vec3 point = glm::vec3(0.0f);
+        glm::vec2 barycentric = glm::vec2(0.0f);
+
+        bool IsValid() const;
+    };
+
+    // En : Inner nodes have `count` 0 and their children at `first` and `first + 1`,
+    // leaves hold the triangles [first, first + count) of the tree order.
+    // Tr : İç düğümlerin `count` değeri 0'dır ve çocukları `first` ve `first + 1`'dedir,
+    // yapraklar ağaç sırasındaki [first, first + count) üçgenlerini tutar.
+    struct BVHNode
+    {
+        AABB bounds;
+        unsigned int first = 0, count = 0;
+    };
+
+    // En : Bounding volume hierarchy over the world space triangles of a set of meshes.
+    // The tree is built top down with binned surface area heuristic splits, the upper levels bin the triangles
+    // in parallel and the lower subtrees are built on separate threads.
+    // When only transforms or vertex positions change, Refit keeps the tree and updates the bounds.
+    // Tr : Bir mesh kümesinin dünya uzayındaki üçgenleri üzerinde sınır hacmi hiyerarşisi.
+    // Ağaç yukarıdan aşağıya gruplanmış yüzey alanı sezgisi bölmeleriyle oluşturulur, üst seviyeler üçgenleri
+    // paralel gruplar ve alt ağaçlar ayrı thread'lerde oluşturulur.
+    // Yalnızca dönüşümler ya da vertex konumları değiştiğinde Refit ağacı korur ve sınırları günceller.
+    class BVH
+    {
+    private:
+        std::vector<BVHNode> nodes;
+        std::vector<Mesh *> meshes;
+        // En : Tree order triangles with the index of their mesh and their three world space corners.
+        // Tr : Mesh indisleri ve üç dünya uzayı köşesi ile ağaç sırasındaki üçgenler.
+        std::vector<TriangleRef> references;
+        std::vector<unsigned int> meshIndices;
+        std::vector<glm::vec3> corners;
+        bool local = false;
+
+        void ReadTriangles(const std::vector<glm::mat4> &transforms, size_t begin, size_t end);
+        std::vector<glm::mat4> GetTransforms() const;
+        void RefitNodes();
+
+    public:
+        // En : Builds the tree over the triangles of the meshes, meshes must be kept alive while the tree is used.
+        // A `local` tree keeps the triangles in mesh space, so it stays valid while the meshes are moved.
+        // Tr : Ağacı meshlerin üçgenleri üzerinde oluşturur, ağaç kullanıldığı sürece meshler yaşamalıdır.
+        // `local` bir ağaç üçgenleri mesh uzayında tutar, böylece meshler hareket ettirilirken geçerli kalır.
+        void Build(const std::vector<Mesh *> &meshes, bool local = false);
+        // En : Reads the world positions of the triangles again and updates the bounds of every node.
+        // Returns false if the triangle count of a mesh changed, the tree must then be built again.
+        // Tr : Üçgenlerin dünya konumlarını yeniden okur ve her düğümün sınırlarını günceller.
+        // Bir meshin üçgen sayısı değiştiyse false döndürür, ağaç bu durumda yeniden oluşturulmalıdır.
+        bool Refit();
+        void Clear();
+
+        // En : Finds the closest triangle hit by the ray within `maxDistance`, both faces are hit.
+        // `distance` is in units of the ray direction.
+        // Tr : Işının `maxDistance` içinde çarptığı en yakın üçgeni bulur, iki yüze de çarpılır.
+        // `distance` ışın yönü biriminde ölçülür.
+        BVHHit Intersect(const Ray &ray, float maxDistance = FLT_MAX) const;
+        // En : Appends the triangles whose bounds overlap the box to `result`.
+        // Tr : Sınırları kutu ile çakışan üçgenleri `result`'a ekler.
+        void Query(const AABB &box, std::vector<TriangleRef> &result) const;
+        // En : Finds the closest point on the triangles to `point` within `maxDistance`.
+        // Tr : Üçgenler üzerinde `point`'e `maxDistance` içindeki en yakın noktayı bulur.
+        BVHHit Nearest(glm::vec3 point, float maxDistance = FLT_MAX) const;
+
+        AABB GetBounds() const;
+        size_t GetNodeCount() const;
+        size_t GetTriangleCount() const;
+        const std::vector<BVHNode> &GetNodes() const;
+        // En : Return the triangle at `index` of the tree order and its three corners, leaves refer to triangles by this order.
+        // Tr : Ağaç sırasındaki `index` konumundaki üçgeni ve üç köşesini döndürür, yapraklar üçgenlere bu sırayla başvurur.
+        TriangleRef GetTriangle(unsigned int index) const;
+        const glm::vec3 *GetCorners(unsigned int index) const;
+    };
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+#ifndef BOUNDS_CPP
+#define BOUNDS_CPP
+
+#include "Bounds.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace parseShape
+{
+    bool AABB::IsValid() const
+    {
+        return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+    }
+    void AABB::Expand(glm::vec3 point)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    void AABB::Expand(const AABB &other)
+    {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+    bool AABB::IsOnBorder(glm::vec3 point) const
+    {
+        return point.x == min.x || point.y == min.y || point.z == min.z ||
+               point.x == max.x || point.y == max.y || point.z == max.z;
+    }
+    glm::vec3 AABB::GetCenter() const
+    {
+        return IsValid() ? (min + max) * 0.5f : glm::vec3(0.0f);
+    }
+    glm::vec3 AABB::GetExtent() const
+    {
+        return IsValid() ? (max - min) * 0.5f : glm::vec3(0.0f);
+    }
+    AABB AABB::Transform(const glm::mat4 &transform) const
+    {
+        if (!IsValid())
+            return *this;
+        // En : The new extent is the extent multiplied by the absolute values of the linear part of the transform.
+        // Tr : Yeni yarı boyut, yarı boyutun dönüşümün doğrusal kısmının mutlak değerleri ile çarpımıdır.
+        glm::vec3 center = transform * glm::vec4(GetCenter(), 1.0f);
+        glm::vec3 extent = GetExtent(), newExtent(0.0f);
+        for (int column = 0; column < 3; column++)
+            for (int row = 0; row < 3; row++)
+                newExtent[row] += std::fabs(transform[column][row]) * extent[column];
+        AABB result;
+        result.min = center - newExtent;
+        result.max = center + newExtent;
+        return result;
+    }
+
+    bool BoundingSphere::IsValid() const
+    {
+        return radius >= 0.0f;
+    }
+    void BoundingSphere::Expand(glm::vec3 point)
+    {
+        if (!IsValid())
+        {
+            center = point;
+            radius = 0.0f;
+            return;
+        }
+        glm::vec3 direction = point - center;
+        float distance = glm::length(direction);
+        if (distance <= radius)
+            return;
+        float newRadius = (radius + distance) * 0.5f;
+        center += direction * ((newRadius - radius) / distance);
+        radius = newRadius;
+    }
+    BoundingSphere BoundingSphere::Transform(const glm::mat4 &transform) const
+    {
+        if (!IsValid())
+            return *this;
+        BoundingSphere result;
+        result.center = transform * glm::vec4(center, 1.0f);
+        float scale = std::max({glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))});
+        result.radius = radius * scale;
+        return result;
+    }
+
+    AABB CalculateBounds(const float *vertices, size_t vertexCount, int vertexSize)
+    {
+        AABB bounds;
+        if (vertexSize < 3)
+            return bounds;
+        for (size_t i = 0; i < vertexCount; i++, vertices += vertexSize)
+            bounds.Expand(glm::vec3(vertices[0], vertices[1], vertices[2]));
+        return bounds;
+    }
+    BoundingSphere CalculateSphere(const float *vertices, size_t vertexCount, int vertexSize, const AABB &bounds)
+    {
+        BoundingSphere sphere;
+        if (vertexSize < 3 || !bounds.IsValid())
+            return sphere;
+        sphere.center = bounds.GetCenter();
+        float radius2 = 0.0f;
+        for (size_t i = 0; i < vertexCount; i++, vertices += vertexSize)
+        {
+            glm::vec3 offset = glm::vec3(vertices[0], vertices[1], vertices[2]) - sphere.center;
+            radius2 = std::max(radius2, glm::dot(offset, offset));
+        }
+        sphere.radius = std::sqrt(radius2);
+        return sphere;
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <glm/glm.hpp>
+#include <cfloat>
+#include <cstddef>
+
+namespace parseShape
+{
+    // En : Axis aligned bounding box, a box with min greater than max is empty.
+    // Tr : Eksenlere hizalı sınır kutusu, min değeri max değerinden büyük olan kutu boştur.
+    struct AABB
+    {
+        glm::vec3 min = glm::vec3(FLT_MAX), max = glm::vec3(-FLT_MAX);
+
+        bool IsValid() const;
+        void Expand(glm::vec3 point);
+        void Expand(const AABB &other);
+        // En : Returns true if the point is on one of the faces of the box.
+        // Tr : Nokta kutunun yüzlerinden birinin üzerindeyse true döndürür.
+        bool IsOnBorder(glm::vec3 point) const;
+        glm::vec3 GetCenter() const;
+        // En : Returns the half size of the box.
+        // Tr : Kutunun yarı boyutunu döndürür.
+        glm::vec3 GetExtent() const;
+        // En : Returns the box that contains this box after the transform, without visiting the corners.
+        // Tr : Bu kutuyu dönüşümden sonra içeren kutuyu köşeleri gezmeden döndürür.
+        AABB Transform(const glm::mat4 &transform) const;
+    };
+
+    // En : Bounding sphere, a negative radius means the sphere is empty.
+    // Tr : Sınır küresi, negatif yarıçap kürenin boş olduğu anlamına gelir.
+    struct BoundingSphere
+    {
+        glm::vec3 center = glm::vec3(0.0f);
+        float radius = -1.0f;
+
+        bool IsValid() const;
+        // En : Grows the sphere just enough to contain the point.
+        // Tr : Küreyi noktayı içerecek kadar büyütür.
+        void Expand(glm::vec3 point);
+        // En : Returns a sphere that contains this sphere after the transform, the radius is scaled by the largest axis scale.
+        // Tr : Bu küreyi dönüşümden sonra içeren bir küre döndürür, yarıçap en büyük eksen ölçeği ile ölçeklenir.
+        BoundingSphere Transform(const glm::mat4 &transform) const;
+    };
+
+    // En : Half line from `origin` along `direction`, the direction does not have to be normalized.
+    // Tr : `origin`'den `direction` boyunca uzanan yarı doğru, yönün normalize olması gerekmez.
+    struct Ray
+    {
+        glm::vec3 origin = glm::vec3(0.0f), direction = glm::vec3(0.0f, 0.0f, -1.0f);
+    };
+
+    // En : Calculates the bounds of the first three floats of every vertex.
+    // `vertexSize` is the number of floats of a vertex.
+    // Tr : Her vertex'in ilk üç float'ının sınırlarını hesaplar.
+    // `vertexSize` bir vertex'in float sayısıdır.
+    AABB CalculateBounds(const float *vertices, size_t vertexCount, int vertexSize);
+    // En : Calculates a sphere around the center of the bounds that contains every vertex.
+    // Tr : Sınırların merkezi etrafında her vertex'i içeren bir küre hesaplar.
+    BoundingSphere CalculateSphere(const float *vertices, size_t vertexCount, int vertexSize, const AABB &bounds);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,268 @@
+#ifndef BUFFERPOOL_CPP
+#define BUFFERPOOL_CPP
+
+#include "BufferPool.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace parseShape
+{
+    static size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool BufferBlock::IsValid() const
+    {
+        return index != UINT32_MAX;
+    }
+    float BufferPoolStats::GetFragmentation() const
+    {
+        size_t free = capacity - used;
+        return free ? 1.0f - (float)largestFree / free : 0.0f;
+    }
+
+#pragma region Constructors and Destructors
+    BufferPool::BufferPool(size_t pageSize, GLenum usage) : pageSize(pageSize), usage(usage)
+    {
+    }
+    BufferPool::~BufferPool()
+    {
+        for (auto &page : pages)
+            if (page.buffer)
+                glDeleteBuffers(1, &page.buffer);
+    }
+    BufferPool *BufferPool::GetShared()
+    {
+        static BufferPool *shared = new BufferPool();
+        return shared;
+    }
+#pragma endregion
+#pragma region Pages
+    uint32_t BufferPool::AddPage(size_t capacity)
+    {
+        uint32_t index = 0;
+        while (index < pages.size() && pages[index].buffer)
+            index++;
+        if (index == pages.size())
+            pages.emplace_back();
+        Page &page = pages[index];
+        page.capacity = capacity;
+        page.used = 0;
+        page.compact = true;
+        page.free.clear();
+        page.free[0] = capacity;
+        glGenBuffers(1, &page.buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, page.buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, capacity, nullptr, usage);
+        return index;
+    }
+    // En : Takes the free range that leaves the least space behind, the alignment padding in front of the block stays free.
+    // Tr : Geride en az boşluk bırakan boş aralığı alır, bloğun önündeki hizalama boşluğu boş kalır.
+    bool BufferPool::Fit(Page &page, size_t size, size_t alignment, size_t &offset)
+    {
+        auto best = page.free.end();
+        size_t bestWaste = SIZE_MAX;
+        for (auto range = page.free.begin(); range != page.free.end(); range++)
+        {
+            size_t aligned = AlignUp(range->first, alignment);
+            if (aligned + size > range->first + range->second || range->second - size >= bestWaste)
+                continue;
+            best = range;
+            bestWaste = range->second - size;
+            offset = aligned;
+        }
+        if (best == page.free.end())
+            return false;
+        size_t begin = best->first, end = begin + best->second;
+        page.free.erase(best);
+        if (offset > begin)
+            page.free[begin] = offset - begin;
+        if (offset + size < end)
+            page.free[offset + size] = end - offset - size;
+        page.used += size;
+        return true;
+    }
+    void BufferPool::Release(Page &page, size_t offset, size_t size)
+    {
+        page.used -= size;
+        page.compact = false;
+        auto next = page.free.lower_bound(offset);
+        if (next != page.free.end() && offset + size == next->first)
+        {
+            size += next->second;
+            next = page.free.erase(next);
+        }
+        if (next != page.free.begin())
+        {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset)
+            {
+                previous->second += size;
+                return;
+            }
+        }
+        page.free.emplace_hint(next, offset, size);
+    }
+    // En : Copies the blocks of the page into a new buffer in offset order without gaps, so all free space ends up at the end.
+    // A new buffer is used since overlapping copies within one buffer are not allowed.
+    // Tr : Sayfanın bloklarını ofset sırasında boşluksuz yeni bir buffer'a kopyalar, böylece tüm boş alan sona toplanır.
+    // Tek bir buffer içinde çakışan kopyalara izin verilmediği için yeni bir buffer kullanılır.
+    void BufferPool::Compact(uint32_t index)
+    {
+        Page &page = pages[index];
+        std::vector<uint32_t> blocks;
+        for (uint32_t i = 0; i < allocations.size(); i++)
+            if (allocations[i].live && allocations[i].page == index)
+                blocks.push_back(i);
+        std::sort(blocks.begin(), blocks.end(), [this](uint32_t a, uint32_t b)
+                  { return allocations[a].offset < allocations[b].offset; });
+
+        GLuint buffer;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, page.capacity, nullptr, usage);
+        glBindBuffer(GL_COPY_READ_BUFFER, page.buffer);
+        page.free.clear();
+        size_t cursor = 0;
+        for (uint32_t i : blocks)
+        {
+            Allocation &allocation = allocations[i];
+            size_t offset = AlignUp(cursor, allocation.alignment);
+            if (offset > cursor)
+                page.free[cursor] = offset - cursor;
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, allocation.offset, offset, allocation.size);
+            bytesMoved += allocation.size;
+            allocation.offset = offset;
+            cursor = offset + allocation.size;
+        }
+        if (cursor < page.capacity)
+            page.free[cursor] = page.capacity - cursor;
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glDeleteBuffers(1, &page.buffer);
+        page.buffer = buffer;
+        page.compact = true;
+        defragmentations++;
+        generation++;
+    }
+#pragma endregion
+#pragma region Blocks
+    BufferBlock BufferPool::Allocate(size_t size, size_t alignment)
+    {
+        BufferBlock block;
+        if (!size)
+            return block;
+        alignment = std::max(alignment, (size_t)1);
+        uint32_t index = UINT32_MAX;
+        size_t offset = 0;
+        for (uint32_t i = 0; i < pages.size() && index == UINT32_MAX; i++)
+            if (pages[i].buffer && Fit(pages[i], size, alignment, offset))
+                index = i;
+        // En : A buffer with enough free bytes that are split into small ranges is compacted before a new buffer is created.
+        // Tr : Yeterli boş baytı küçük aralıklara bölünmüş bir buffer, yeni bir buffer oluşturulmadan önce sıkıştırılır.
+        for (uint32_t i = 0; i < pages.size() && index == UINT32_MAX; i++)
+        {
+            if (!pages[i].buffer || pages[i].compact || pages[i].capacity - pages[i].used < size + alignment - 1)
+                continue;
+            Compact(i);
+            if (Fit(pages[i], size, alignment, offset))
+                index = i;
+        }
+        if (index == UINT32_MAX)
+        {
+            index = AddPage(std::max(pageSize, size));
+            Fit(pages[index], size, alignment, offset);
+        }
+
+        if (freeAllocations.empty())
+        {
+            block.index = allocations.size();
+            allocations.emplace_back();
+            generations.push_back(0);
+        }
+        else
+        {
+            block.index = freeAllocations.back();
+            freeAllocations.pop_back();
+        }
+        block.generation = generations[block.index];
+        Allocation &allocation = allocations[block.index];
+        allocation.page = index;
+        allocation.offset = offset;
+        allocation.size = size;
+        allocation.alignment = alignment;
+        allocation.live = true;
+        return block;
+    }
+    void BufferPool::Free(BufferBlock &block)
+    {
+        if (!IsValid(block))
+            return;
+        Allocation &allocation = allocations[block.index];
+        Release(pages[allocation.page], allocation.offset, allocation.size);
+        allocation.live = false;
+        generations[block.index]++;
+        freeAllocations.push_back(block.index);
+        block = BufferBlock();
+    }
+    bool BufferPool::IsValid(BufferBlock block) const
+    {
+        return block.index < allocations.size() && allocations[block.index].live && generations[block.index] == block.generation;
+    }
+    GLuint BufferPool::GetBuffer(BufferBlock block) const
+    {
+        return IsValid(block) ? pages[allocations[block.index].page].buffer : 0;
+    }
+    size_t BufferPool::GetOffset(BufferBlock block) const
+    {
+        return IsValid(block) ? allocations[block.index].offset : 0;
+    }
+    size_t BufferPool::GetSize(BufferBlock block) const
+    {
+        return IsValid(block) ? allocations[block.index].size : 0;
+    }
+#pragma endregion
+#pragma region Maintenance
+    void BufferPool::Defragment()
+    {
+        for (uint32_t i = 0; i < pages.size(); i++)
+        {
+            Page &page = pages[i];
+            if (!page.buffer)
+                continue;
+            if (!page.used)
+            {
+                glDeleteBuffers(1, &page.buffer);
+                page = Page();
+            }
+            else if (!page.compact)
+                Compact(i);
+        }
+    }
+    uint32_t BufferPool::GetGeneration() const
+    {
+        return generation;
+    }
+    BufferPoolStats BufferPool::GetStats() const
+    {
+        BufferPoolStats stats;
+        for (auto &page : pages)
+        {
+            if (!page.buffer)
+                continue;
+            stats.buffers++;
+            stats.capacity += page.capacity;
+            stats.used += page.used;
+            stats.freeBlocks += page.free.size();
+            for (auto &range : page.free)
+                stats.largestFree = std::max(stats.largestFree, range.second);
+        }
+        stats.blocks = allocations.size() - freeAllocations.size();
+        stats.defragmentations = defragmentations;
+        stats.bytesMoved = bytesMoved;
+        return stats;
+    }
+#pragma endregion
+}
+#endif
\ No newline at end of file
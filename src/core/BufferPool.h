@@ -0,0 +1,108 @@
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+
+#include <map>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <GL/glew.h>
+
+namespace parseShape
+{
+    // En : Stable reference to a block of a buffer pool, its buffer and offset may change when the pool is defragmented.
+    // Tr : Bir buffer havuzundaki bloğa kalıcı referans, havuz birleştirildiğinde buffer'ı ve ofseti değişebilir.
+    struct BufferBlock
+    {
+        uint32_t index = UINT32_MAX, generation = 0;
+
+        bool IsValid() const;
+    };
+
+    // En : Usage of a buffer pool, `largestFree` is the biggest block that can be allocated without growing the pool.
+    // Tr : Bir buffer havuzunun kullanımı, `largestFree` havuzu büyütmeden ayrılabilecek en büyük bloktur.
+    struct BufferPoolStats
+    {
+        size_t buffers = 0, capacity = 0, used = 0, blocks = 0, freeBlocks = 0, largestFree = 0;
+        size_t defragmentations = 0, bytesMoved = 0;
+
+        // En : Returns the part of the free memory that is not in the largest free block, 0 if the free memory is contiguous.
+        // Tr : Boş belleğin en büyük boş blokta olmayan kısmını döndürür, boş bellek bitişikse 0 döner.
+        float GetFragmentation() const;
+    };
+
+    // En : Suballocates ranges of a few large GPU buffers, so many meshes and scenes share buffers instead of each owning
+    // its own. Every buffer keeps its free ranges ordered by offset and merges neighbours when a block is freed.
+    // When no free range fits but a buffer has enough free bytes in total, the buffer is compacted into a new one.
+    // Blocks that moved are found through their handles, owners compare GetGeneration to know when to rebind.
+    // Tr : Birkaç büyük GPU buffer'ından aralıklar ayırır, böylece birçok mesh ve sahne her biri kendi buffer'ına sahip olmak
+    // yerine buffer'ları paylaşır. Her buffer boş aralıklarını ofsete göre sıralı tutar ve bir blok serbest bırakıldığında
+    // komşuları birleştirir. Hiçbir boş aralık sığmadığında ama bir buffer'da toplamda yeterli boş bayt olduğunda buffer
+    // yenisine sıkıştırılır. Taşınan bloklar handle'ları ile bulunur, sahipler ne zaman yeniden bağlanacaklarını bilmek
+    // için GetGeneration'ı karşılaştırır.
+    class BufferPool
+    {
+    private:
+        struct Page
+        {
+            GLuint buffer = 0;
+            size_t capacity = 0, used = 0;
+            // En : Free ranges by offset.
+            // Tr : Ofsete göre boş aralıklar.
+            std::map<size_t, size_t> free;
+            // En : True while no block was freed since the page was created or compacted.
+            // Tr : Sayfa oluşturulduğundan ya da sıkıştırıldığından beri hiçbir blok serbest bırakılmadıysa true.
+            bool compact = true;
+        };
+        struct Allocation
+        {
+            uint32_t page = 0;
+            size_t offset = 0, size = 0, alignment = 1;
+            bool live = false;
+        };
+        std::vector<Page> pages;
+        std::vector<Allocation> allocations;
+        std::vector<uint32_t> generations, freeAllocations;
+        size_t pageSize;
+        GLenum usage;
+        uint32_t generation = 0;
+        size_t defragmentations = 0, bytesMoved = 0;
+
+        bool Fit(Page &page, size_t size, size_t alignment, size_t &offset);
+        void Release(Page &page, size_t offset, size_t size);
+        void Compact(uint32_t page);
+        uint32_t AddPage(size_t capacity);
+
+    public:
+        // En : New buffers hold at least `pageSize` bytes, larger blocks get a buffer of their own size.
+        // Tr : Yeni buffer'lar en az `pageSize` bayt tutar, daha büyük bloklar kendi boyutlarında bir buffer alır.
+        BufferPool(size_t pageSize = 32 * 1024 * 1024, GLenum usage = GL_STATIC_DRAW);
+        BufferPool(const BufferPool &) = delete;
+        BufferPool &operator=(const BufferPool &) = delete;
+        ~BufferPool();
+        // En : Returns the pool shared by every scene. It is never deleted, since the context it belongs to may be gone at exit.
+        // Tr : Her sahnenin paylaştığı havuzu döndürür. Ait olduğu bağlam çıkışta yok olmuş olabileceğinden asla silinmez.
+        static BufferPool *GetShared();
+
+        // En : Allocates `size` bytes at an offset that is a multiple of `alignment`. The contents are undefined.
+        // Tr : `alignment`'ın katı olan bir ofsette `size` bayt ayırır. İçerik tanımsızdır.
+        BufferBlock Allocate(size_t size, size_t alignment = 4);
+        // En : Frees the block and invalidates the handle.
+        // Tr : Bloğu serbest bırakır ve handle'ı geçersiz kılar.
+        void Free(BufferBlock &block);
+        bool IsValid(BufferBlock block) const;
+        // En : Return the buffer, byte offset and size of the block, the buffer is 0 for an invalid block.
+        // Tr : Bloğun buffer'ını, bayt ofsetini ve boyutunu döndürür, geçersiz bir blok için buffer 0'dır.
+        GLuint GetBuffer(BufferBlock block) const;
+        size_t GetOffset(BufferBlock block) const;
+        size_t GetSize(BufferBlock block) const;
+
+        // En : Compacts every buffer that had blocks freed since it was last compacted and deletes the empty ones.
+        // Tr : Son sıkıştırılmasından beri blokları serbest bırakılmış her buffer'ı sıkıştırır ve boş olanları siler.
+        void Defragment();
+        // En : Changes whenever blocks move to another buffer or offset.
+        // Tr : Bloklar başka bir buffer'a ya da ofsete taşındığında değişir.
+        uint32_t GetGeneration() const;
+        BufferPoolStats GetStats() const;
+    };
+}
+#endif
\ No newline at end of file
@@ -34,6 +34,7 @@ namespace parseShape
     glm::mat4 Camera::GetViewMatrix() const
     {
 
+        glm::vec3 position = GetPosition();
         return glm::lookAt(position, position + GetFront(), GetUp());
     }
     // En : Returns the perspective matrix.
@@ -66,6 +67,34 @@ namespace parseShape
     {
         return glm::mat4(1.0f);
     }
+    // En : Returns the ratio of the screen height covered by a sphere.
+    // `center` : Center of the sphere in world space.
+    // `radius` : Radius of the sphere.
+    // Tr : Bir kürenin kapladığı ekran yüksekliği oranını döndürür.
+    // `center` : Kürenin dünya uzayındaki merkezi.
+    // `radius` : Kürenin yarıçapı.
+    float Camera::GetScreenSize(glm::vec3 center, float radius) const
+    {
+        // En : [1][1] of the projection is 1 / tan(fov / 2) for perspective and 2 / (top - bottom) for orthographic.
+        // Tr : Projeksiyonun [1][1] elemanı perspektif için 1 / tan(fov / 2), ortografik için 2 / (top - bottom)'dır.
+        float scale = GetProjectionMatrix()[1][1];
+        if (type == CameraType::Orthographic)
+            return radius * scale;
+        float distance = glm::length(center - GetPosition());
+        if (distance <= radius)
+            return 1.0f;
+        return radius * scale / distance;
+    }
+    Ray Camera::GetRay(glm::vec2 screen) const
+    {
+        glm::mat4 inverse = glm::inverse(GetProjectionMatrix() * GetViewMatrix());
+        glm::vec4 nearPoint = inverse * glm::vec4(screen.x, screen.y, -1.0f, 1.0f);
+        glm::vec4 farPoint = inverse * glm::vec4(screen.x, screen.y, 1.0f, 1.0f);
+        Ray ray;
+        ray.origin = glm::vec3(nearPoint) / nearPoint.w;
+        ray.direction = glm::normalize(glm::vec3(farPoint) / farPoint.w - ray.origin);
+        return ray;
+    }
     // En : Sets the perspective properties.
     // `fov` : Field of view.
     // `aspect` : Aspect ratio.
@@ -6,6 +6,7 @@
 
 #include "Object.h"
 #include "Shader.h"
+#include "Bounds.h"
 namespace parseShape
 {
     enum class CameraType
@@ -38,6 +39,14 @@ namespace parseShape
         glm::mat4 GetOrthographicMatrix() const;
         glm::mat4 GetProjectionMatrix() const;
         glm::mat4 GetModelMatrix() const;
+        // En : Returns the ratio of the screen height covered by a sphere.
+        // Tr : Bir kürenin kapladığı ekran yüksekliği oranını döndürür.
+        float GetScreenSize(glm::vec3 center, float radius) const;
+        // En : Returns the world space ray through a point of the screen, `screen` is in normalized device coordinates.
+        // The ray starts on the near plane and its direction is normalized.
+        // Tr : Ekranın bir noktasından geçen dünya uzayı ışınını döndürür, `screen` normalize cihaz koordinatlarındadır.
+        // Işın yakın düzlemde başlar ve yönü normalize edilmiştir.
+        Ray GetRay(glm::vec2 screen) const;
 
         void SetPerspective(float fov, float aspect, float near, float far);
         void SetOrthographic(float left, float right, float bottom, float top, float near, float far);
@@ -0,0 +1,321 @@
+#ifndef COLLISION_CPP
+#define COLLISION_CPP
+
+#include "Collision.h"
+#include "Parallel.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace parseShape
+{
+    namespace
+    {
+        // En : Bodies a thread sweeps at once and candidate pairs a thread tests at once.
+        // Tr : Bir thread'in tek seferde süpürdüğü gövdeler ve tek seferde test ettiği aday çiftler.
+        const size_t sweepBatch = 64, pairBatch = 4;
+
+        bool Overlaps(const AABB &a, const AABB &b)
+        {
+            return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y &&
+                   a.min.z <= b.max.z && b.min.z <= a.max.z;
+        }
+        AABB TriangleBounds(const glm::vec3 *corner)
+        {
+            AABB box;
+            box.min = glm::min(corner[0], glm::min(corner[1], corner[2]));
+            box.max = glm::max(corner[0], glm::max(corner[1], corner[2]));
+            return box;
+        }
+        float Volume(const AABB &box)
+        {
+            glm::vec3 size = box.max - box.min;
+            return size.x * size.y * size.z;
+        }
+        // En : Returns true if the projections of the triangles on the axis are apart, or overlap by no more than `tolerance`.
+        // Axes of almost zero length come from parallel edges and never separate.
+        // Tr : Üçgenlerin eksen üzerindeki izdüşümleri ayrıksa ya da `tolerance`'tan fazla çakışmıyorsa true döndürür.
+        // Neredeyse sıfır uzunluktaki eksenler paralel kenarlardan gelir ve asla ayırmaz.
+        bool Separates(glm::vec3 axis, const glm::vec3 *a, const glm::vec3 *b, float tolerance)
+        {
+            float lengthSquared = glm::dot(axis, axis);
+            if (lengthSquared < 1e-12f)
+                return false;
+            float a0 = glm::dot(axis, a[0]), a1 = glm::dot(axis, a[1]), a2 = glm::dot(axis, a[2]);
+            float b0 = glm::dot(axis, b[0]), b1 = glm::dot(axis, b[1]), b2 = glm::dot(axis, b[2]);
+            float minA = std::min(a0, std::min(a1, a2)), maxA = std::max(a0, std::max(a1, a2));
+            float minB = std::min(b0, std::min(b1, b2)), maxB = std::max(b0, std::max(b1, b2));
+            float margin = tolerance * std::sqrt(lengthSquared);
+            return maxA < minB + margin || maxB < minA + margin;
+        }
+    }
+
+    // En : Separating axis test, the candidates are the two normals, the cross products of the edge pairs and the in plane
+    // normals of the edges, the last ones separate coplanar triangles.
+    // Tr : Ayırıcı eksen testi, adaylar iki normal, kenar çiftlerinin vektörel çarpımları ve kenarların düzlem içi
+    // normalleridir, sonuncular aynı düzlemdeki üçgenleri ayırır.
+    bool TrianglesIntersect(const glm::vec3 *a, const glm::vec3 *b, float tolerance)
+    {
+        glm::vec3 edgesA[3] = {a[1] - a[0], a[2] - a[1], a[0] - a[2]};
+        glm::vec3 edgesB[3] = {b[1] - b[0], b[2] - b[1], b[0] - b[2]};
+        glm::vec3 normalA = glm::cross(edgesA[0], edgesA[1]), normalB = glm::cross(edgesB[0], edgesB[1]);
+        if (Separates(normalA, a, b, tolerance) || Separates(normalB, a, b, tolerance))
+            return false;
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                if (Separates(glm::cross(edgesA[i], edgesB[j]), a, b, tolerance))
+                    return false;
+        for (int i = 0; i < 3; i++)
+            if (Separates(glm::cross(normalA, edgesA[i]), a, b, tolerance) || Separates(glm::cross(normalB, edgesB[i]), a, b, tolerance))
+                return false;
+        return true;
+    }
+
+#pragma region Bodies
+    int CollisionWorld::Find(Mesh *mesh) const
+    {
+        for (size_t i = 0; i < bodies.size(); i++)
+            if (bodies[i].mesh == mesh)
+                return (int)i;
+        return -1;
+    }
+    void CollisionWorld::Add(Mesh *mesh)
+    {
+        if (!mesh || Find(mesh) >= 0)
+            return;
+        bodies.emplace_back();
+        bodies.back().mesh = mesh;
+        order.push_back(bodies.size() - 1);
+    }
+    void CollisionWorld::Remove(Mesh *mesh)
+    {
+        int index = Find(mesh);
+        if (index < 0)
+            return;
+        bodies.erase(bodies.begin() + index);
+        order.erase(std::find(order.begin(), order.end(), (unsigned int)index));
+        for (auto &body : order)
+            if (body > (unsigned int)index)
+                body--;
+        contacts.clear();
+    }
+    void CollisionWorld::Clear()
+    {
+        bodies.clear();
+        order.clear();
+        contacts.clear();
+        stats = CollisionStats();
+    }
+    size_t CollisionWorld::Size() const
+    {
+        return bodies.size();
+    }
+    void CollisionWorld::Invalidate(Mesh *mesh)
+    {
+        int index = Find(mesh);
+        if (index >= 0)
+            bodies[index].dirty = true;
+    }
+    void CollisionWorld::SetTolerance(float tolerance)
+    {
+        this->tolerance = tolerance;
+    }
+    float CollisionWorld::GetTolerance() const
+    {
+        return tolerance;
+    }
+#pragma endregion
+#pragma region Broadphase
+    // En : Every body is compared with the bodies after it in the order until their lower bound passes its upper bound.
+    // Each batch of the order writes its own list, the lists are joined in order so the result does not depend on the threads.
+    // Tr : Her gövde sıradaki kendisinden sonraki gövdelerle, alt sınırları onun üst sınırını geçene kadar karşılaştırılır.
+    // Sıranın her grubu kendi listesini yazar, listeler sırayla birleştirilir, böylece sonuç thread'lere bağlı değildir.
+    void CollisionWorld::Sweep()
+    {
+        const size_t batches = (order.size() + sweepBatch - 1) / sweepBatch;
+        sweepPairs.resize(batches);
+        ParallelFor(batches, [this](size_t begin, size_t end)
+                    {
+            for (size_t batch = begin; batch < end; batch++)
+            {
+                std::vector<std::pair<unsigned int, unsigned int>> &pairs = sweepPairs[batch];
+                pairs.clear();
+                size_t last = std::min((batch + 1) * sweepBatch, order.size());
+                for (size_t i = batch * sweepBatch; i < last; i++)
+                {
+                    const AABB &box = bodies[order[i]].bounds;
+                    for (size_t j = i + 1; j < order.size(); j++)
+                    {
+                        const AABB &other = bodies[order[j]].bounds;
+                        if (other.min[axis] > box.max[axis])
+                            break;
+                        if (Overlaps(box, other))
+                            pairs.push_back({std::min(order[i], order[j]), std::max(order[i], order[j])});
+                    }
+                }
+            } }, 1);
+        candidates.clear();
+        for (auto &pairs : sweepPairs)
+            candidates.insert(candidates.end(), pairs.begin(), pairs.end());
+    }
+#pragma endregion
+#pragma region Narrowphase
+    // En : Descends both trees at once in the mesh space of `a`, the node with the larger box is split first.
+    // The triangles of two leaves are compared in world space, so the tolerance does not depend on the scale of the meshes.
+    // Tr : İki ağaçta aynı anda `a`'nın mesh uzayında iner, kutusu daha büyük olan düğüm önce bölünür.
+    // İki yaprağın üçgenleri dünya uzayında karşılaştırılır, böylece tolerans meshlerin ölçeğine bağlı değildir.
+    bool CollisionWorld::Intersect(const Body &a, const Body &b, ContactPair &contact) const
+    {
+        const std::vector<BVHNode> &nodesA = a.tree.GetNodes(), &nodesB = b.tree.GetNodes();
+        if (nodesA.empty() || nodesB.empty())
+            return false;
+        const glm::mat4 toA = a.inverse * b.transform;
+        std::vector<std::pair<unsigned int, unsigned int>> stack = {{0, 0}};
+        std::vector<glm::vec3> cornersA, cornersB;
+        while (!stack.empty())
+        {
+            auto entry = stack.back();
+            stack.pop_back();
+            const BVHNode &nodeA = nodesA[entry.first], &nodeB = nodesB[entry.second];
+            AABB boxB = nodeB.bounds.Transform(toA);
+            if (!Overlaps(nodeA.bounds, boxB))
+                continue;
+            if (nodeA.count && nodeB.count)
+            {
+                cornersA.resize(nodeA.count * 3);
+                cornersB.resize(nodeB.count * 3);
+                for (unsigned int i = 0; i < nodeA.count * 3; i++)
+                    cornersA[i] = glm::vec3(a.transform * glm::vec4(a.tree.GetCorners(nodeA.first)[i], 1.0f));
+                for (unsigned int i = 0; i < nodeB.count * 3; i++)
+                    cornersB[i] = glm::vec3(b.transform * glm::vec4(b.tree.GetCorners(nodeB.first)[i], 1.0f));
+                for (unsigned int i = 0; i < nodeA.count; i++)
+                {
+                    AABB triangleA = TriangleBounds(&cornersA[i * 3]);
+                    for (unsigned int j = 0; j < nodeB.count; j++)
+                    {
+                        if (!Overlaps(triangleA, TriangleBounds(&cornersB[j * 3])) ||
+                            !TrianglesIntersect(&cornersA[i * 3], &cornersB[j * 3], tolerance))
+                            continue;
+                        contact.first = a.mesh;
+                        contact.second = b.mesh;
+                        contact.firstTriangle = a.tree.GetTriangle(nodeA.first + i).triangle;
+                        contact.secondTriangle = b.tree.GetTriangle(nodeB.first + j).triangle;
+                        return true;
+                    }
+                }
+                continue;
+            }
+            if (nodeB.count || (!nodeA.count && Volume(nodeA.bounds) >= Volume(boxB)))
+            {
+                stack.push_back({nodeA.first + 1, entry.second});
+                stack.push_back({nodeA.first, entry.second});
+            }
+            else
+            {
+                stack.push_back({entry.first, nodeB.first + 1});
+                stack.push_back({entry.first, nodeB.first});
+            }
+        }
+        return false;
+    }
+    bool CollisionWorld::Test(Mesh *first, Mesh *second, ContactPair *contact) const
+    {
+        int a = Find(first), b = Find(second);
+        if (a < 0 || b < 0 || a == b || bodies[a].dirty || bodies[b].dirty)
+            return false;
+        ContactPair result;
+        if (!Overlaps(bodies[a].bounds, bodies[b].bounds) || !Intersect(bodies[a], bodies[b], result))
+            return false;
+        if (contact)
+            *contact = result;
+        return true;
+    }
+#pragma endregion
+#pragma region Update
+    const std::vector<ContactPair> &CollisionWorld::Update()
+    {
+        stats = CollisionStats();
+        stats.bodies = bodies.size();
+        std::vector<unsigned int> dirty;
+        for (unsigned int i = 0; i < bodies.size(); i++)
+            if (bodies[i].dirty)
+                dirty.push_back(i);
+        ParallelFor(dirty.size(), [&](size_t begin, size_t end)
+                    {
+            for (size_t i = begin; i < end; i++)
+            {
+                Body &body = bodies[dirty[i]];
+                body.tree.Build({body.mesh}, true);
+                body.dirty = false;
+            } }, 1);
+        stats.rebuilt = dirty.size();
+
+        ParallelFor(bodies.size(), [this](size_t begin, size_t end)
+                    {
+            for (size_t i = begin; i < end; i++)
+            {
+                Body &body = bodies[i];
+                body.transform = body.mesh->GetTransform();
+                body.inverse = glm::inverse(body.transform);
+                body.bounds = body.tree.GetBounds().Transform(body.transform);
+            } }, sweepBatch);
+
+        // En : The sweep axis is the one the centers vary most along, the order is only sorted from scratch when it changes.
+        // Tr : Süpürme ekseni merkezlerin en çok değiştiği eksendir, sıra yalnızca eksen değiştiğinde baştan sıralanır.
+        glm::vec3 sum(0.0f), sumSquared(0.0f);
+        size_t valid = 0;
+        for (auto &body : bodies)
+        {
+            if (!body.bounds.IsValid())
+                continue;
+            glm::vec3 center = body.bounds.GetCenter();
+            sum += center;
+            sumSquared += center * center;
+            valid++;
+        }
+        glm::vec3 variance = valid ? sumSquared / (float)valid - (sum / (float)valid) * (sum / (float)valid) : glm::vec3(0.0f);
+        int best = variance.y > variance[0] ? 1 : 0;
+        best = variance.z > variance[best] ? 2 : best;
+        auto lower = [this](unsigned int a, unsigned int b)
+        { return bodies[a].bounds.min[axis] < bodies[b].bounds.min[axis]; };
+        if (best != axis)
+        {
+            axis = best;
+            std::sort(order.begin(), order.end(), lower);
+        }
+        else
+            for (size_t i = 1; i < order.size(); i++)
+            {
+                unsigned int body = order[i];
+                size_t j = i;
+                for (; j > 0 && lower(body, order[j - 1]); j--)
+                    order[j] = order[j - 1];
+                order[j] = body;
+            }
+        Sweep();
+        stats.candidates = candidates.size();
+
+        hits.assign(candidates.size(), 0);
+        found.resize(candidates.size());
+        ParallelFor(candidates.size(), [this](size_t begin, size_t end)
+                    {
+            for (size_t i = begin; i < end; i++)
+                hits[i] = Intersect(bodies[candidates[i].first], bodies[candidates[i].second], found[i]); }, pairBatch);
+        contacts.clear();
+        for (size_t i = 0; i < candidates.size(); i++)
+            if (hits[i])
+                contacts.push_back(found[i]);
+        stats.contacts = contacts.size();
+        return contacts;
+    }
+    const std::vector<ContactPair> &CollisionWorld::GetContacts() const
+    {
+        return contacts;
+    }
+    CollisionStats CollisionWorld::GetStats() const
+    {
+        return stats;
+    }
+#pragma endregion
+}
+#endif
\ No newline at end of file
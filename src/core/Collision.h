@@ -0,0 +1,100 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "Mesh.h"
+#include "Bounds.h"
+#include "BVH.h"
+
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+namespace parseShape
+{
+    // En : Two meshes whose triangles intersect, with the first intersecting triangle found of each.
+    // Triangles are indices of their first index divided by three.
+    // Tr : Üçgenleri kesişen iki mesh, her birinin bulunan ilk kesişen üçgeni ile.
+    // Üçgenler ilk index'lerinin üçe bölümüdür.
+    struct ContactPair
+    {
+        Mesh *first = nullptr, *second = nullptr;
+        unsigned int firstTriangle = 0, secondTriangle = 0;
+    };
+
+    // En : Counts of the last update, `candidates` are the pairs with overlapping bounds that were tested triangle by triangle.
+    // Tr : Son güncellemenin sayıları, `candidates` sınırları çakışan ve üçgen üçgen test edilen çiftlerdir.
+    struct CollisionStats
+    {
+        size_t bodies = 0, candidates = 0, contacts = 0, rebuilt = 0;
+    };
+
+    // En : Returns true if the triangles intersect. They must overlap by more than `tolerance` along every separating axis,
+    // so with 0 touching triangles intersect too.
+    // Tr : Üçgenler kesişiyorsa true döndürür. Her ayırıcı eksen boyunca `tolerance`'tan fazla çakışmalıdırlar,
+    // böylece 0 ile değen üçgenler de kesişir.
+    bool TrianglesIntersect(const glm::vec3 *a, const glm::vec3 *b, float tolerance = 0.0f);
+
+    // En : Finds the meshes that intersect each other. The broadphase sweeps the world bounds of the meshes along the axis
+    // they are spread most on, the order of the last update is kept and re-sorted with an insertion sort, which is nearly
+    // linear while parts move a little every frame. Every candidate pair is tested with the mesh space trees of both
+    // meshes, the boxes of one tree are moved into the space of the other, so moving a mesh never rebuilds its tree.
+    // Both phases run in parallel. Meshes are tested as surfaces, a part completely inside another is not a contact.
+    // Tr : Birbiriyle kesişen meshleri bulur. Geniş faz meshlerin dünya sınırlarını en çok yayıldıkları eksen boyunca süpürür,
+    // son güncellemenin sırası korunur ve eklemeli sıralama ile yeniden sıralanır, bu parçalar her karede biraz hareket
+    // ederken neredeyse doğrusaldır. Her aday çift iki meshin mesh uzayındaki ağaçlarıyla test edilir, bir ağacın kutuları
+    // diğerinin uzayına taşınır, böylece bir meshi hareket ettirmek ağacını asla yeniden oluşturmaz. İki faz da paralel çalışır.
+    // Meshler yüzey olarak test edilir, tamamen başka bir parçanın içindeki bir parça temas değildir.
+    class CollisionWorld
+    {
+    private:
+        struct Body
+        {
+            Mesh *mesh = nullptr;
+            BVH tree;
+            bool dirty = true;
+            AABB bounds;
+            glm::mat4 transform = glm::mat4(1.0f), inverse = glm::mat4(1.0f);
+        };
+        std::vector<Body> bodies;
+        // En : Bodies sorted by the lower bound along `axis`.
+        // Tr : `axis` boyunca alt sınıra göre sıralanmış gövdeler.
+        std::vector<unsigned int> order;
+        int axis = 0;
+        std::vector<std::vector<std::pair<unsigned int, unsigned int>>> sweepPairs;
+        std::vector<std::pair<unsigned int, unsigned int>> candidates;
+        std::vector<ContactPair> found;
+        std::vector<unsigned char> hits;
+        std::vector<ContactPair> contacts;
+        float tolerance = 0.0f;
+        CollisionStats stats;
+
+        int Find(Mesh *mesh) const;
+        void Sweep();
+        bool Intersect(const Body &a, const Body &b, ContactPair &contact) const;
+
+    public:
+        // En : Adds a mesh, it must be kept alive while it is in the world.
+        // Tr : Bir mesh ekler, dünyada olduğu sürece yaşamalıdır.
+        void Add(Mesh *mesh);
+        void Remove(Mesh *mesh);
+        void Clear();
+        size_t Size() const;
+        // En : Builds the tree of the mesh again on the next update, called after its vertices or indices were changed.
+        // Tr : Meshin ağacını sonraki güncellemede yeniden oluşturur, vertex'leri ya da index'leri değiştirildikten sonra çağrılır.
+        void Invalidate(Mesh *mesh);
+        // En : Sets how deep triangles must overlap to count as a contact, 0 counts touching parts.
+        // Tr : Üçgenlerin temas sayılması için ne kadar derin çakışması gerektiğini ayarlar, 0 değen parçaları sayar.
+        void SetTolerance(float tolerance);
+        float GetTolerance() const;
+
+        // En : Reads the transforms of the meshes and returns every pair of meshes that intersect.
+        // Tr : Meshlerin dönüşümlerini okur ve kesişen her mesh çiftini döndürür.
+        const std::vector<ContactPair> &Update();
+        const std::vector<ContactPair> &GetContacts() const;
+        CollisionStats GetStats() const;
+        // En : Tests two meshes of the world with their transforms as of the last update, `contact` receives the triangles.
+        // Tr : Dünyadaki iki meshi son güncellemedeki dönüşümleriyle test eder, `contact` üçgenleri alır.
+        bool Test(Mesh *first, Mesh *second, ContactPair *contact = nullptr) const;
+    };
+}
+#endif
\ No newline at end of file
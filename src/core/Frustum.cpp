@@ -0,0 +1,125 @@
+#ifndef FRUSTUM_CPP
+#define FRUSTUM_CPP
+
+#include "Frustum.h"
+#include "Simd.h"
+
+#include <cmath>
+
+namespace parseShape
+{
+    bool Frustum::Intersects(const AABB &box) const
+    {
+        if (!box.IsValid())
+            return false;
+        glm::vec3 center = box.GetCenter(), extent = box.GetExtent();
+        for (const glm::vec4 &plane : planes)
+        {
+            float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+            float radius = glm::dot(glm::abs(glm::vec3(plane)), extent);
+            if (distance + radius < 0.0f)
+                return false;
+        }
+        return true;
+    }
+    bool Frustum::Intersects(const BoundingSphere &sphere) const
+    {
+        if (!sphere.IsValid())
+            return false;
+        for (const glm::vec4 &plane : planes)
+            if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+                return false;
+        return true;
+    }
+
+    Frustum CreateFrustum(const glm::mat4 &viewProjection)
+    {
+        // En : Every plane is the last row of the matrix plus or minus one of the other rows, glm stores columns.
+        // Tr : Her düzlem matrisin son satırı artı ya da eksi diğer satırlardan biridir, glm sütunları saklar.
+        glm::mat4 rows = glm::transpose(viewProjection);
+        Frustum frustum;
+        for (int i = 0; i < 3; i++)
+        {
+            frustum.planes[i * 2] = rows[3] + rows[i];
+            frustum.planes[i * 2 + 1] = rows[3] - rows[i];
+        }
+        for (glm::vec4 &plane : frustum.planes)
+        {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f)
+                plane /= length;
+        }
+        return frustum;
+    }
+
+    void BoxArray::Resize(size_t count)
+    {
+        centerX.resize(count);
+        centerY.resize(count);
+        centerZ.resize(count);
+        extentX.resize(count);
+        extentY.resize(count);
+        extentZ.resize(count);
+    }
+    size_t BoxArray::Size() const
+    {
+        return centerX.size();
+    }
+    void BoxArray::Set(size_t index, const AABB &box)
+    {
+        glm::vec3 center = box.GetCenter(), extent = box.GetExtent();
+        // En : An empty box gets a negative extent so it is never visible.
+        // Tr : Boş bir kutu hiçbir zaman görünmesin diye negatif yarı boyut alır.
+        if (!box.IsValid())
+            extent = glm::vec3(-FLT_MAX);
+        centerX[index] = center.x;
+        centerY[index] = center.y;
+        centerZ[index] = center.z;
+        extentX[index] = extent.x;
+        extentY[index] = extent.y;
+        extentZ[index] = extent.z;
+    }
+
+    size_t CullBoxes(const Frustum &frustum, const BoxArray &boxes, std::vector<unsigned char> &visible)
+    {
+        size_t count = boxes.Size(), visibleCount = 0, i = 0;
+        visible.resize(count);
+#ifdef PARSESHAPE_SSE2
+        __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 cx = _mm_loadu_ps(&boxes.centerX[i]), cy = _mm_loadu_ps(&boxes.centerY[i]), cz = _mm_loadu_ps(&boxes.centerZ[i]);
+            __m128 ex = _mm_loadu_ps(&boxes.extentX[i]), ey = _mm_loadu_ps(&boxes.extentY[i]), ez = _mm_loadu_ps(&boxes.extentZ[i]);
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (const glm::vec4 &plane : frustum.planes)
+            {
+                __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), cx), _mm_mul_ps(_mm_set1_ps(plane.y), cy)),
+                                             _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), cz), _mm_set1_ps(plane.w)));
+                __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(plane.x)), ex), _mm_mul_ps(_mm_set1_ps(std::fabs(plane.y)), ey)),
+                                           _mm_mul_ps(_mm_set1_ps(std::fabs(plane.z)), ez));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+            }
+            int mask = _mm_movemask_ps(inside);
+            for (int lane = 0; lane < 4; lane++)
+            {
+                visible[i + lane] = (mask >> lane) & 1;
+                visibleCount += visible[i + lane];
+            }
+        }
+#endif
+        for (; i < count; i++)
+        {
+            bool inside = true;
+            for (const glm::vec4 &plane : frustum.planes)
+            {
+                float distance = plane.x * boxes.centerX[i] + plane.y * boxes.centerY[i] + plane.z * boxes.centerZ[i] + plane.w;
+                float radius = std::fabs(plane.x) * boxes.extentX[i] + std::fabs(plane.y) * boxes.extentY[i] + std::fabs(plane.z) * boxes.extentZ[i];
+                inside &= distance + radius >= 0.0f;
+            }
+            visible[i] = inside;
+            visibleCount += inside;
+        }
+        return visibleCount;
+    }
+}
+#endif
\ No newline at end of file
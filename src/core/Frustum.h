@@ -0,0 +1,45 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include "Bounds.h"
+
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+namespace parseShape
+{
+    // En : View frustum as six planes with normalized normals pointing inside: left, right, bottom, top, near, far.
+    // Tr : İçeriyi gösteren normalize edilmiş normallere sahip altı düzlem olarak görüş piramidi: sol, sağ, alt, üst, yakın, uzak.
+    struct Frustum
+    {
+        glm::vec4 planes[6];
+
+        // En : Returns false if the box is completely outside one of the planes.
+        // Tr : Kutu düzlemlerden birinin tamamen dışındaysa false döndürür.
+        bool Intersects(const AABB &box) const;
+        bool Intersects(const BoundingSphere &sphere) const;
+    };
+
+    // En : Extracts the planes of the frustum from a projection * view matrix.
+    // Tr : Görüş piramidinin düzlemlerini bir projeksiyon * görünüm matrisinden çıkarır.
+    Frustum CreateFrustum(const glm::mat4 &viewProjection);
+
+    // En : Boxes stored as separate center and extent arrays, so four of them are tested at once.
+    // Tr : Ayrı merkez ve yarı boyut dizileri olarak saklanan kutular, böylece dördü aynı anda test edilir.
+    struct BoxArray
+    {
+        std::vector<float> centerX, centerY, centerZ, extentX, extentY, extentZ;
+
+        void Resize(size_t count);
+        size_t Size() const;
+        void Set(size_t index, const AABB &box);
+    };
+
+    // En : Tests every box against the frustum, `visible` receives 1 for the boxes that intersect it.
+    // Returns the number of visible boxes.
+    // Tr : Her kutuyu görüş piramidine karşı test eder, `visible` onunla kesişen kutular için 1 alır.
+    // Görünür kutuların sayısını döndürür.
+    size_t CullBoxes(const Frustum &frustum, const BoxArray &boxes, std::vector<unsigned char> &visible);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,307 @@
+#ifndef LIGHT_CPP
+#define LIGHT_CPP
+
+#include "Light.h"
+#include "Parallel.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace parseShape
+{
+    // En : Names of the uniforms the grid sets, a shader that declares `lightCount` shades with the lights of its cell.
+    // Tr : Izgaranın ayarladığı uniform'ların adları, `lightCount` tanımlayan bir shader hücresinin ışıklarıyla gölgelendirir.
+    static const char *lightDataName = "lightData", *lightCellsName = "lightCells", *lightIndicesName = "lightIndices";
+
+#pragma region Light
+    Light::Light(glm::vec3 color, float intensity, float range) : color(color), intensity(intensity), range(range)
+    {
+    }
+    void Light::SetColor(glm::vec3 color)
+    {
+        this->color = color;
+    }
+    void Light::SetIntensity(float intensity)
+    {
+        this->intensity = intensity;
+    }
+    void Light::SetRange(float range)
+    {
+        this->range = range;
+    }
+    glm::vec3 Light::GetColor() const
+    {
+        return color;
+    }
+    float Light::GetIntensity() const
+    {
+        return intensity;
+    }
+    float Light::GetRange() const
+    {
+        return range;
+    }
+#pragma endregion
+#pragma region Constructors and Destructors
+    LightGrid::LightGrid(int tilesX, int tilesY, int slices) : tilesX(std::max(tilesX, 1)), tilesY(std::max(tilesY, 1)), slices(std::max(slices, 1))
+    {
+        cells.assign((size_t)this->tilesX * this->tilesY * this->slices * 2, 0);
+        sliceIndices.resize(this->slices);
+        slicePairs.resize(this->slices);
+    }
+    LightGrid::~LightGrid()
+    {
+        if (buffers[0])
+        {
+            glDeleteBuffers(3, buffers);
+            glDeleteTextures(3, textures);
+        }
+    }
+#pragma endregion
+#pragma region Assignment
+    float LightGrid::SliceDepth(int slice) const
+    {
+        float t = (float)slice / slices;
+        return perspective ? zNear * std::pow(zFar / zNear, t) : zNear + (zFar - zNear) * t;
+    }
+    int LightGrid::SliceOf(float depth) const
+    {
+        float slice = (perspective ? std::log(std::max(depth, zNear)) : depth) * depthScale + depthBias;
+        return std::min(std::max((int)std::floor(slice), 0), slices - 1);
+    }
+    // En : Tests the lights that reach the slice against its cells. The tiles a light can touch are found from the
+    // screen bounds of its sphere within the slice first, then every tile is tested with the view space box of its cell.
+    // The lights of the slice are counted per cell and written in cell order, offsets are relative to the slice.
+    // Tr : Dilime ulaşan ışıkları hücrelerine karşı test eder. Bir ışığın dokunabileceği karolar önce küresinin dilim
+    // içindeki ekran sınırlarından bulunur, ardından her karo hücresinin görünüm uzayı kutusuyla test edilir.
+    // Dilimin ışıkları hücre başına sayılır ve hücre sırasında yazılır, ofsetler dilime görelidir.
+    void LightGrid::AssignSlice(int slice)
+    {
+        const int tiles = tilesX * tilesY;
+        unsigned int *counts = cells.data() + (size_t)slice * tiles * 2;
+        for (int i = 0; i < tiles; i++)
+            counts[i * 2 + 1] = 0;
+        std::vector<unsigned int> &list = sliceIndices[slice];
+        list.clear();
+        const float sliceNear = SliceDepth(slice), sliceFar = SliceDepth(slice + 1);
+        const glm::vec2 scale(projection[0][0], projection[1][1]), offset(projection[2][0], projection[2][1]),
+            shift(projection[3][0], projection[3][1]);
+        const int tileCount[2] = {tilesX, tilesY};
+
+        // En : Maps a view space coordinate range of the sphere to the range of tiles along one axis.
+        // Tr : Kürenin bir görünüm uzayı koordinat aralığını bir eksen boyunca karo aralığına eşler.
+        auto tileRange = [&](int axis, float low, float high, float depthNear, float depthFar, int &first, int &last)
+        {
+            float ndcLow, ndcHigh;
+            if (perspective)
+            {
+                ndcLow = scale[axis] * low / (low < 0.0f ? depthNear : depthFar) - offset[axis];
+                ndcHigh = scale[axis] * high / (high > 0.0f ? depthNear : depthFar) - offset[axis];
+            }
+            else
+            {
+                ndcLow = scale[axis] * low + shift[axis];
+                ndcHigh = scale[axis] * high + shift[axis];
+            }
+            if (ndcHigh < -1.0f || ndcLow > 1.0f)
+                return false;
+            first = std::max((int)std::floor((ndcLow + 1.0f) * 0.5f * tileCount[axis]), 0);
+            last = std::min((int)std::floor((ndcHigh + 1.0f) * 0.5f * tileCount[axis]), tileCount[axis] - 1);
+            return first <= last;
+        };
+        // En : View space range of the cells of a tile along one axis, the frustum widens with the depth.
+        // Tr : Bir karonun hücrelerinin bir eksen boyuncaki görünüm uzayı aralığı, piramit derinlikle genişler.
+        auto cellRange = [&](int axis, int tile, float &low, float &high)
+        {
+            float ndcLow = -1.0f + 2.0f * tile / tileCount[axis], ndcHigh = -1.0f + 2.0f * (tile + 1) / tileCount[axis];
+            if (perspective)
+            {
+                float a = (ndcLow + offset[axis]) / scale[axis], b = (ndcHigh + offset[axis]) / scale[axis];
+                low = std::min(a * sliceNear, a * sliceFar);
+                high = std::max(b * sliceNear, b * sliceFar);
+            }
+            else
+            {
+                low = (ndcLow - shift[axis]) / scale[axis];
+                high = (ndcHigh - shift[axis]) / scale[axis];
+            }
+        };
+
+        std::vector<unsigned int> &pairs = slicePairs[slice];
+        pairs.clear();
+        for (unsigned int light = 0; light < spheres.size(); light++)
+        {
+            if (slice < firstSlice[light] || slice > lastSlice[light])
+                continue;
+            const glm::vec4 &sphere = spheres[light];
+            float depth = -sphere.z, radius = sphere.w;
+            float depthNear = std::max(sliceNear, depth - radius), depthFar = std::min(sliceFar, depth + radius);
+            int firstX, lastX, firstY, lastY;
+            if (!tileRange(0, sphere.x - radius, sphere.x + radius, depthNear, depthFar, firstX, lastX) ||
+                !tileRange(1, sphere.y - radius, sphere.y + radius, depthNear, depthFar, firstY, lastY))
+                continue;
+            float dz = std::max(std::max(sliceNear - depth, depth - sliceFar), 0.0f);
+            for (int y = firstY; y <= lastY; y++)
+            {
+                float low, high;
+                cellRange(1, y, low, high);
+                float dy = std::max(std::max(low - sphere.y, sphere.y - high), 0.0f);
+                for (int x = firstX; x <= lastX; x++)
+                {
+                    cellRange(0, x, low, high);
+                    float dx = std::max(std::max(low - sphere.x, sphere.x - high), 0.0f);
+                    if (dx * dx + dy * dy + dz * dz > radius * radius)
+                        continue;
+                    unsigned int cell = y * tilesX + x;
+                    counts[cell * 2 + 1]++;
+                    pairs.push_back(cell);
+                    pairs.push_back(light);
+                }
+            }
+        }
+        unsigned int cursor = 0;
+        for (int i = 0; i < tiles; i++)
+        {
+            counts[i * 2] = cursor;
+            cursor += counts[i * 2 + 1];
+        }
+        list.resize(cursor);
+        for (int i = 0; i < tiles; i++)
+            counts[i * 2 + 1] = 0;
+        for (size_t i = 0; i < pairs.size(); i += 2)
+        {
+            unsigned int *cell = counts + pairs[i] * 2;
+            list[cell[0] + cell[1]++] = pairs[i + 1];
+        }
+    }
+    void LightGrid::Assign(const std::vector<Light *> &lights, const glm::mat4 &view, const glm::mat4 &projection)
+    {
+        this->projection = projection;
+        perspective = projection[3][3] == 0.0f;
+        if (perspective)
+        {
+            zNear = projection[3][2] / (projection[2][2] - 1.0f);
+            zFar = projection[3][2] / (projection[2][2] + 1.0f);
+            depthScale = slices / std::log(zFar / zNear);
+            depthBias = -std::log(zNear) * depthScale;
+        }
+        else
+        {
+            zNear = (projection[3][2] + 1.0f) / projection[2][2];
+            zFar = (projection[3][2] - 1.0f) / projection[2][2];
+            depthScale = slices / (zFar - zNear);
+            depthBias = -zNear * depthScale;
+        }
+
+        spheres.resize(lights.size());
+        firstSlice.resize(lights.size());
+        lastSlice.resize(lights.size());
+        lightData.resize(std::max(lights.size() * 2, (size_t)1));
+        for (size_t i = 0; i < lights.size(); i++)
+        {
+            const Light *light = lights[i];
+            glm::vec3 position(light->GetTransform()[3]);
+            float range = light->GetRange();
+            lightData[i * 2] = glm::vec4(position, range);
+            lightData[i * 2 + 1] = glm::vec4(light->GetColor() * light->GetIntensity(), 0.0f);
+            spheres[i] = glm::vec4(glm::vec3(view * glm::vec4(position, 1.0f)), range);
+            float depth = -spheres[i].z;
+            if (range <= 0.0f || depth + range < zNear || depth - range > zFar)
+            {
+                firstSlice[i] = 1;
+                lastSlice[i] = 0;
+                continue;
+            }
+            firstSlice[i] = SliceOf(depth - range);
+            lastSlice[i] = SliceOf(depth + range);
+        }
+
+        ParallelFor(slices, [this](size_t begin, size_t end)
+                    {
+                        for (size_t slice = begin; slice < end; slice++)
+                            AssignSlice((int)slice);
+                    },
+                    1);
+        // En : The slice lists are joined in slice order, so the offsets of each slice move by the lists before it.
+        // Tr : Dilim listeleri dilim sırasında birleştirilir, böylece her dilimin ofsetleri önceki listeler kadar kayar.
+        const size_t tiles = (size_t)tilesX * tilesY;
+        indices.clear();
+        for (int slice = 0; slice < slices; slice++)
+        {
+            unsigned int base = indices.size();
+            unsigned int *counts = cells.data() + slice * tiles * 2;
+            for (size_t i = 0; i < tiles; i++)
+                counts[i * 2] += base;
+            indices.insert(indices.end(), sliceIndices[slice].begin(), sliceIndices[slice].end());
+        }
+    }
+#pragma endregion
+#pragma region GPU
+    void LightGrid::Upload()
+    {
+        if (!buffers[0])
+        {
+            glGenBuffers(3, buffers);
+            glGenTextures(3, textures);
+        }
+        // En : Texture buffers can not be empty, an empty list is uploaded as one unused index.
+        // Tr : Doku buffer'ları boş olamaz, boş bir liste kullanılmayan tek bir indis olarak yüklenir.
+        const unsigned int none = 0;
+        const void *data[3] = {lightData.data(), cells.data(), indices.empty() ? &none : indices.data()};
+        const size_t sizes[3] = {lightData.size() * sizeof(glm::vec4), cells.size() * sizeof(unsigned int),
+                                 std::max(indices.size(), (size_t)1) * sizeof(unsigned int)};
+        const GLenum formats[3] = {GL_RGBA32F, GL_RG32UI, GL_R32UI};
+        for (int i = 0; i < 3; i++)
+        {
+            glBindBuffer(GL_TEXTURE_BUFFER, buffers[i]);
+            glBufferData(GL_TEXTURE_BUFFER, sizes[i], data[i], GL_STREAM_DRAW);
+            glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+            glTexBuffer(GL_TEXTURE_BUFFER, formats[i], buffers[i]);
+        }
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+    void LightGrid::Bind(int firstUnit) const
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+            glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+        }
+        glActiveTexture(GL_TEXTURE0);
+    }
+    void LightGrid::SetUniforms(Shader *shader, int firstUnit, glm::vec2 viewport) const
+    {
+        shader->Set(lightDataName, firstUnit);
+        shader->Set(lightCellsName, firstUnit + 1);
+        shader->Set(lightIndicesName, firstUnit + 2);
+        shader->Set("lightCount", (int)spheres.size());
+        shader->Set("lightGrid", glm::vec3(tilesX, tilesY, slices));
+        shader->Set("lightTileScale", glm::vec2(tilesX / std::max(viewport.x, 1.0f), tilesY / std::max(viewport.y, 1.0f)));
+        shader->Set("lightDepth", glm::vec3(depthScale, depthBias, perspective ? 1.0f : 0.0f));
+    }
+#pragma endregion
+#pragma region Queries
+    size_t LightGrid::GetLightCount() const
+    {
+        return spheres.size();
+    }
+    size_t LightGrid::GetCellCount() const
+    {
+        return (size_t)tilesX * tilesY * slices;
+    }
+    unsigned int LightGrid::GetCellLightCount(int x, int y, int slice) const
+    {
+        return cells[(((size_t)slice * tilesY + y) * tilesX + x) * 2 + 1];
+    }
+    const unsigned int *LightGrid::GetCellLights(int x, int y, int slice) const
+    {
+        return indices.data() + cells[(((size_t)slice * tilesY + y) * tilesX + x) * 2];
+    }
+    size_t LightGrid::GetIndexCount() const
+    {
+        return indices.size();
+    }
+#pragma endregion
+}
+#endif
\ No newline at end of file
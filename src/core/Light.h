@@ -0,0 +1,100 @@
+#ifndef LIGHT_H
+#define LIGHT_H
+
+#include "Object.h"
+#include "Shader.h"
+
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <GL/glew.h>
+
+namespace parseShape
+{
+    // En : A point light at the world position of the object, its light fades to zero at `range`.
+    // Tr : Nesnenin dünya konumunda bir nokta ışık, ışığı `range` mesafesinde sıfıra iner.
+    class Light : public Object
+    {
+    private:
+        glm::vec3 color = glm::vec3(1.0f);
+        float intensity = 1.0f, range = 10.0f;
+
+    public:
+        Light() = default;
+        Light(glm::vec3 color, float intensity, float range);
+
+        void SetColor(glm::vec3 color);
+        void SetIntensity(float intensity);
+        void SetRange(float range);
+        glm::vec3 GetColor() const;
+        float GetIntensity() const;
+        float GetRange() const;
+    };
+
+    // En : Assigns lights to the cells of a grid that splits the view frustum into screen tiles and depth slices.
+    // Slices get exponentially deeper with the distance for perspective cameras, so cells stay roughly cubic.
+    // Every cell gets the offset and count of its lights in one index list, so a fragment only loops over the lights
+    // that reach its cell. The assignment runs on the CPU, the slices are handled in parallel.
+    // Tr : Işıkları görüş piramidini ekran karolarına ve derinlik dilimlerine bölen bir ızgaranın hücrelerine atar.
+    // Perspektif kameralarda dilimler uzaklıkla üstel olarak derinleşir, böylece hücreler kabaca küp kalır.
+    // Her hücre tek bir indis listesinde ışıklarının ofsetini ve sayısını alır, böylece bir fragment yalnızca hücresine
+    // ulaşan ışıklar üzerinde döner. Atama CPU'da çalışır, dilimler paralel işlenir.
+    class LightGrid
+    {
+    private:
+        int tilesX, tilesY, slices;
+        // En : View space sphere of every light, lights that can not be seen get no slices.
+        // Tr : Her ışığın görünüm uzayı küresi, görülemeyen ışıklar dilim almaz.
+        std::vector<glm::vec4> spheres;
+        std::vector<int> firstSlice, lastSlice;
+        // En : Two texels per light: world position and range, color times intensity.
+        // Tr : Işık başına iki texel: dünya konumu ve menzil, renk çarpı yoğunluk.
+        std::vector<glm::vec4> lightData;
+        // En : Offset and count of every cell in `indices`, cells are ordered by slice, then row, then column.
+        // Tr : Her hücrenin `indices` içindeki ofseti ve sayısı, hücreler dilime, sonra satıra, sonra sütuna göre sıralıdır.
+        std::vector<unsigned int> cells, indices;
+        // En : Lights of every slice and the cell and light pairs they were sorted from, kept to reuse their memory.
+        // Tr : Her dilimin ışıkları ve sıralandıkları hücre ve ışık çiftleri, bellekleri yeniden kullanılsın diye tutulur.
+        std::vector<std::vector<unsigned int>> sliceIndices, slicePairs;
+        glm::mat4 projection = glm::mat4(1.0f);
+        float zNear = 0.1f, zFar = 100.0f, depthScale = 1.0f, depthBias = 0.0f;
+        bool perspective = true;
+        GLuint buffers[3] = {0, 0, 0}, textures[3] = {0, 0, 0};
+
+        float SliceDepth(int slice) const;
+        int SliceOf(float depth) const;
+        void AssignSlice(int slice);
+
+    public:
+        LightGrid(int tilesX = 16, int tilesY = 9, int slices = 24);
+        LightGrid(const LightGrid &) = delete;
+        LightGrid &operator=(const LightGrid &) = delete;
+        ~LightGrid();
+
+        // En : Assigns the lights to the cells of the frustum of `projection`, the view matrix moves them into view space.
+        // Only the CPU lists are built, Upload sends them to the GPU.
+        // Tr : Işıkları `projection`'ın görüş piramidinin hücrelerine atar, görünüm matrisi onları görünüm uzayına taşır.
+        // Yalnızca CPU listeleri oluşturulur, Upload onları GPU'ya gönderir.
+        void Assign(const std::vector<Light *> &lights, const glm::mat4 &view, const glm::mat4 &projection);
+        // En : Uploads the lights, the cells and the index list into texture buffers.
+        // Tr : Işıkları, hücreleri ve indis listesini doku buffer'larına yükler.
+        void Upload();
+        // En : Binds the texture buffers to `firstUnit` and the two units after it and sets the uniforms of the grid,
+        // `viewport` is the size of the framebuffer in pixels.
+        // Tr : Doku buffer'larını `firstUnit`'e ve ondan sonraki iki birime bağlar ve ızgaranın uniform'larını ayarlar,
+        // `viewport` framebuffer'ın piksel cinsinden boyutudur.
+        void Bind(int firstUnit) const;
+        void SetUniforms(Shader *shader, int firstUnit, glm::vec2 viewport) const;
+
+        size_t GetLightCount() const;
+        size_t GetCellCount() const;
+        // En : Return the number of lights in the cell and the lights themselves, as indices into the list given to Assign.
+        // Tr : Hücredeki ışık sayısını ve ışıkların kendilerini Assign'a verilen listedeki indisler olarak döndürür.
+        unsigned int GetCellLightCount(int x, int y, int slice) const;
+        const unsigned int *GetCellLights(int x, int y, int slice) const;
+        // En : Returns the total length of the cell lists, a light is counted once for every cell it reaches.
+        // Tr : Hücre listelerinin toplam uzunluğunu döndürür, bir ışık ulaştığı her hücre için bir kez sayılır.
+        size_t GetIndexCount() const;
+    };
+}
+#endif
\ No newline at end of file
@@ -5,15 +5,25 @@
 #include <GL/glew.h>
 #include <iostream>
 #include <numeric>
+#include <algorithm>
 
 #include "Mesh.h"
+#include "MeshBuilder.h"
+#include "Primitive.h"
 
 namespace parseShape
 {
     Mesh::Mesh(std::vector<float> vertices, std::vector<unsigned int> indices)
     {
-        this->vertices = vertices;
-        this->indices = indices;
+        this->vertices = std::move(vertices);
+        this->indices = std::move(indices);
+    }
+    Mesh::Mesh(std::vector<float> vertices, std::vector<unsigned int> indices, int vertexSize)
+    {
+        this->vertices = std::move(vertices);
+        this->indices = std::move(indices);
+        this->vertexSize = vertexSize;
+        vertexCount = vertexSize > 0 ? this->vertices.size() / vertexSize : 0;
     }
     Mesh::Mesh(int vertexCount, int vertexSize)
     {
@@ -37,6 +47,67 @@ namespace parseShape
     {
     }
 
+    glm::vec3 Mesh::PositionOf(int index) const
+    {
+        if (vertexSize < 3)
+            return glm::vec3(0.0f);
+        return glm::vec3(vertices[index * vertexSize], vertices[index * vertexSize + 1], vertices[index * vertexSize + 2]);
+    }
+    // En: The pivot of the transform follows the bounds, so a vertex change also makes the world matrix stale.
+    // Tr: Dönüşümün pivotu sınırları izler, bu yüzden bir vertex değişikliği dünya matrisini de eskitir.
+    void Mesh::MarkChanged(unsigned int begin, unsigned int end)
+    {
+        InvalidateTransform();
+        if (changedBegin == changedEnd)
+        {
+            changedBegin = begin;
+            changedEnd = end;
+            return;
+        }
+        changedBegin = std::min(changedBegin, begin);
+        changedEnd = std::max(changedEnd, end);
+    }
+    // En: Recalculates the bounds if a change may have shrunk them.
+    // Tr: Bir değişiklik sınırları küçültmüş olabilirse sınırları yeniden hesaplar.
+    void Mesh::UpdateBounds() const
+    {
+        if (!boundsDirty)
+            return;
+        bounds = CalculateBounds(vertices.data(), vertexCount, vertexSize);
+        sphere = CalculateSphere(vertices.data(), vertexCount, vertexSize, bounds);
+        boundsDirty = false;
+    }
+    // En: Grows the bounds with the vertices starting from `firstVertex`.
+    // Tr: Sınırları `firstVertex` ile başlayan vertex'lerle büyütür.
+    void Mesh::ExpandBounds(size_t firstVertex)
+    {
+        if (boundsDirty || vertexSize < 3)
+            return;
+        for (size_t i = firstVertex; i < (size_t)vertexCount; i++)
+        {
+            glm::vec3 position = PositionOf(i);
+            bounds.Expand(position);
+            sphere.Expand(position);
+        }
+    }
+    // En: Updates the bounds after the position of a vertex changed, they are only recalculated if the vertex was on the border.
+    // `previous` is the old position of the vertex.
+    // Tr: Bir vertex'in konumu değiştikten sonra sınırları günceller, yalnızca vertex sınırın üzerindeyse yeniden hesaplanırlar.
+    // `previous` vertex'in eski konumudur.
+    void Mesh::ChangeBounds(glm::vec3 previous, int index)
+    {
+        if (boundsDirty || vertexSize < 3)
+            return;
+        if (bounds.IsOnBorder(previous))
+        {
+            boundsDirty = true;
+            return;
+        }
+        glm::vec3 position = PositionOf(index);
+        bounds.Expand(position);
+        sphere.Expand(position);
+    }
+
     void Mesh::Adapt(Shader *shader)
     {
         if (!shader || shader->GetAttributeSize() != vertexSize)
@@ -52,11 +123,14 @@ namespace parseShape
     // `vertex` is a vector of floats.
     // Tr: Mesh'e bir vertex ekler.
     // `vertex`, float'ların vektörüdür.
-    void Mesh::AddVertex(std::vector<float> vertex)
+    void Mesh::AddVertex(const std::vector<float> &vertex)
     {
         int sizeDiffrence = vertex.size() % vertexSize;
+        size_t firstVertex = vertexCount;
         vertices.insert(vertices.end(), vertex.begin(), vertex.end() - sizeDiffrence);
         vertexCount = vertices.size() / vertexSize;
+        ExpandBounds(firstVertex);
+        MarkChanged(firstVertex, vertexCount);
     }
     // En: Adds a vertex to the mesh.
     // `vertex` is an array of floats.
@@ -67,17 +141,21 @@ namespace parseShape
     void Mesh::AddVertex(float *vertex, int size)
     {
         int sizeDiffrence = size % vertexSize;
+        size_t firstVertex = vertexCount;
         vertices.insert(vertices.end(), vertex, vertex + size - sizeDiffrence);
         vertexCount = vertices.size() / vertexSize;
+        ExpandBounds(firstVertex);
+        MarkChanged(firstVertex, vertexCount);
     }
     // En: Adds indices to the mesh.
     // `indices` is a vector of unsigned integers.
     // Tr: Mesh'e indisler ekler.
     // `indices`, unsigned int'lerin vektörüdür.
-    void Mesh::AddIndices(std::vector<unsigned int> indices)
+    void Mesh::AddIndices(const std::vector<unsigned int> &indices)
     {
         if (indices.size() % 3 == 0)
             this->indices.insert(this->indices.end(), indices.begin(), indices.end());
+        indicesChanged = true;
     }
     // En: Adds indices to the mesh.
     // `indices` is an array of unsigned integers.
@@ -89,6 +167,7 @@ namespace parseShape
     {
         if (size % 3 == 0)
             this->indices.insert(this->indices.end(), indices, indices + size);
+        indicesChanged = true;
     }
     // En: Adds indices to the mesh.
     // `a`, `b`, and `c` are unsigned integers.
@@ -99,6 +178,7 @@ namespace parseShape
         indices.push_back(a);
         indices.push_back(b);
         indices.push_back(c);
+        indicesChanged = true;
     }
     // En: Changes the vertex at the specified index and offset with the given value.
     // `value` is a glm::vec3 for 3D vertices.
@@ -110,9 +190,13 @@ namespace parseShape
     // `offset`, vertexin offseti.
     void Mesh::ChangeVertex(glm::vec3 value, int index, int offset)
     {
+        glm::vec3 previous = PositionOf(index);
         vertices[index * vertexSize + offset] = value.x;
         vertices[index * vertexSize + offset + 1] = value.y;
         vertices[index * vertexSize + offset + 2] = value.z;
+        if (offset < 3)
+            ChangeBounds(previous, index);
+        MarkChanged(index, index + 1);
     }
     // En: Changes the vertex at the specified index and offset with the given value.
     // `value` is a glm::vec2 for 2D vertices.
@@ -124,8 +208,12 @@ namespace parseShape
     // `offset`, vertexin offseti.
     void Mesh::ChangeVertex(glm::vec2 value, int index, int offset)
     {
+        glm::vec3 previous = PositionOf(index);
         vertices[index * vertexSize + offset] = value.x;
         vertices[index * vertexSize + offset + 1] = value.y;
+        if (offset < 3)
+            ChangeBounds(previous, index);
+        MarkChanged(index, index + 1);
     }
     // En: Changes the vertex at the specified index and offset with the given value.
     // `value` is a float for 1D vertices.
@@ -137,7 +225,11 @@ namespace parseShape
     // `offset`, vertexin offseti.
     void Mesh::ChangeVertex(float value, int index, int offset)
     {
+        glm::vec3 previous = PositionOf(index);
         vertices[index * vertexSize + offset] = value;
+        if (offset < 3)
+            ChangeBounds(previous, index);
+        MarkChanged(index, index + 1);
     }
     void Mesh::ChangeVertex(unsigned int index, float value, const char *name)
     {
@@ -173,12 +265,70 @@ namespace parseShape
     // `indices`, unsigned int'lerin vektörüdür.
     void Mesh::SetIndices(std::vector<unsigned int> indices)
     {
-        this->indices = indices;
+        this->indices = std::move(indices);
+        indicesChanged = true;
+        lods.clear();
+    }
+    // En: Replaces the vertices of the mesh.
+    // `vertices` is a vector of floats, its size should be a multiple of the vertex size.
+    // Tr: Meshin vertexlerini değiştirir.
+    // `vertices`, float'ların vektörüdür, boyutu vertex boyutunun katı olmalıdır.
+    void Mesh::SetVertices(std::vector<float> vertices)
+    {
+        this->vertices = std::move(vertices);
+        vertexCount = vertexSize > 0 ? this->vertices.size() / vertexSize : 0;
+        boundsDirty = true;
+        MarkChanged(0, vertexCount);
+        indicesChanged = true;
+        lods.clear();
+    }
+    // En: Adds a lower detail level to the mesh.
+    // `indices` are the indices of the level, they refer to the vertices of the mesh.
+    // `screenSize` is the screen height ratio below which the level is drawn.
+    // Tr: Meshe daha düşük detaylı bir seviye ekler.
+    // `indices` seviyenin index'leridir, meshin vertex'lerini gösterir.
+    // `screenSize` altında seviyenin çizildiği ekran yüksekliği oranıdır.
+    void Mesh::AddLOD(std::vector<unsigned int> indices, float screenSize)
+    {
+        lods.push_back({std::move(indices), screenSize});
+        indicesChanged = true;
+    }
+    // En: Removes all lower detail levels.
+    // Tr: Tüm düşük detaylı seviyeleri siler.
+    void Mesh::ClearLODs()
+    {
+        lods.clear();
+        indicesChanged = true;
+    }
+    // En: Returns the number of lower detail levels.
+    // Tr: Düşük detaylı seviye sayısını döndürür.
+    int Mesh::GetLODCount() const
+    {
+        return lods.size();
+    }
+    // En: Returns the lower detail level, `level` starts from 0 for the first reduced level.
+    // Tr: Düşük detaylı seviyeyi döndürür, `level` ilk azaltılmış seviye için 0'dan başlar.
+    const MeshLOD &Mesh::GetLOD(int level) const
+    {
+        return lods[level];
+    }
+    // En: Selects the level to draw.
+    // `screenSize` is the ratio of the screen height the mesh covers.
+    // Tr: Çizilecek seviyeyi seçer.
+    // `screenSize` meshin kapladığı ekran yüksekliği oranıdır.
+    int Mesh::SelectLOD(float screenSize) const
+    {
+        for (int i = lods.size() - 1; i >= 0; i--)
+            if (screenSize < lods[i].screenSize)
+                return i + 1;
+        return 0;
     }
     void Mesh::DoTransformations(unsigned int begin, unsigned int offset)
     {
         if (offset < 3)
             return;
+        glm::vec3 position = GetPosition(), scale = GetScale();
+        glm::quat rotation = GetRotation();
         for (int i = begin; i < vertices.size(); i += offset)
         {
             glm::vec3 vertex(vertices[i], vertices[i + 1], vertices[i + 2]);
@@ -191,6 +341,8 @@ namespace parseShape
             vertices[i + 1] = vertex.y;
             vertices[i + 2] = vertex.z;
         }
+        boundsDirty = true;
+        MarkChanged(0, vertexCount);
     }
     void Mesh::DoTransformations()
     {
@@ -216,12 +368,44 @@ namespace parseShape
     {
         return vertexSize;
     }
+    // En: Returns the bounds of the positions in mesh space.
+    // Tr: Mesh uzayındaki konumların sınırlarını döndürür.
+    AABB Mesh::GetLocalBounds() const
+    {
+        UpdateBounds();
+        return bounds;
+    }
+    // En: Returns the bounding sphere of the positions in mesh space.
+    // Tr: Mesh uzayındaki konumların sınır küresini döndürür.
+    BoundingSphere Mesh::GetLocalSphere() const
+    {
+        UpdateBounds();
+        return sphere;
+    }
+    // En: Returns the center of the bounds, the mesh rotates and scales around it.
+    // Tr: Sınırların merkezini döndürür, mesh onun etrafında döner ve ölçeklenir.
+    glm::vec3 Mesh::GetPivot() const
+    {
+        return GetLocalBounds().GetCenter();
+    }
     // En: Returns the vertices of the mesh.
     // Tr: Meshin vertexlerini döndürür.
     std::vector<float> Mesh::GetVertices() const
     {
         return vertices;
     }
+    // En: Returns the raw vertex data of the mesh.
+    // Tr: Meshin ham vertex verisini döndürür.
+    const std::vector<float> &Mesh::GetVertexData() const
+    {
+        return vertices;
+    }
+    // En: Returns the raw index data of the mesh.
+    // Tr: Meshin ham index verisini döndürür.
+    const std::vector<unsigned int> &Mesh::GetIndexData() const
+    {
+        return indices;
+    }
     // En: Returns the vertices of the mesh.
     // `size` is the size of the vertices.
     // Tr: Meshin vertexlerini döndürür.
@@ -230,26 +414,86 @@ namespace parseShape
     {
         size = vertices.size();
         float *data = new float[size];
-        std::copy(vertices.begin(), vertices.end(), data);
-
-        glm::vec3 center = std::accumulate(vertices.begin(), vertices.end(), glm::vec3(0.0f)) / (float)vertexCount;
-
-        glm::mat4 transform = glm::rotate(glm::mat4(1.0f), glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f)) *
-                              glm::rotate(glm::mat4(1.0f), glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f)) *
-                              glm::rotate(glm::mat4(1.0f), glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f)) *
-                              glm::scale(glm::mat4(1.0f), scale);
-
-        for (int i = 0; i < vertexCount; i++)
+        WriteVertices(data);
+        return data;
+    }
+    // En: Writes the transformed vertices to `destination`.
+    // Tr: Dönüştürülmüş vertex'leri `destination`'a yazar.
+    void Mesh::WriteVertices(float *destination) const
+    {
+        WriteVertices(destination, 0, vertexCount);
+        size_t written = (size_t)vertexCount * vertexSize;
+        if (written < vertices.size())
+            std::copy(vertices.begin() + written, vertices.end(), destination + written);
+    }
+    void Mesh::WriteVertices(float *destination, unsigned int begin, unsigned int end, int normalOffset) const
+    {
+        end = std::min(end, (unsigned int)vertexCount);
+        if (begin >= end || vertexSize <= 0)
+            return;
+        const float *source = vertices.data() + (size_t)begin * vertexSize;
+        if (vertexSize < 3)
         {
-            glm::vec3 vertex(vertices[i * vertexSize], vertices[i * vertexSize + 1], vertices[i * vertexSize + 2]);
-            vertex -= center;
-            vertex = transform * glm::vec4(vertex, 1.0f);
-            vertex += center + position;
-            data[i * vertexSize] = vertex.x;
-            data[i * vertexSize + 1] = vertex.y;
-            data[i * vertexSize + 2] = vertex.z;
+            std::copy(source, source + (size_t)(end - begin) * vertexSize, destination);
+            return;
+        }
+        glm::mat4 transform = GetTransform();
+        bool normals = normalOffset >= 3 && normalOffset + 3 <= vertexSize;
+        glm::mat3 normalMatrix = normals ? glm::transpose(glm::inverse(glm::mat3(transform))) : glm::mat3(1.0f);
+        for (unsigned int i = begin; i < end; i++, source += vertexSize, destination += vertexSize)
+        {
+            glm::vec3 vertex = transform * glm::vec4(source[0], source[1], source[2], 1.0f);
+            destination[0] = vertex.x;
+            destination[1] = vertex.y;
+            destination[2] = vertex.z;
+            std::copy(source + 3, source + vertexSize, destination + 3);
+            if (!normals)
+                continue;
+            glm::vec3 normal = normalMatrix * glm::vec3(source[normalOffset], source[normalOffset + 1], source[normalOffset + 2]);
+            float length = glm::length(normal);
+            if (length > 0.0f)
+                normal /= length;
+            destination[normalOffset] = normal.x;
+            destination[normalOffset + 1] = normal.y;
+            destination[normalOffset + 2] = normal.z;
         }
-        return data;
+    }
+    // En: Returns true if a vertex changed, the changed vertices are in [begin, end).
+    // Tr: Bir vertex değiştiyse true döndürür, değişen vertex'ler [begin, end) aralığındadır.
+    bool Mesh::GetChangedVertices(unsigned int &begin, unsigned int &end) const
+    {
+        begin = changedBegin;
+        end = std::min(changedEnd, (unsigned int)vertexCount);
+        return begin < end;
+    }
+    // En: Returns true if the indices or the levels of detail changed.
+    // Tr: Index'ler ya da detay seviyeleri değiştiyse true döndürür.
+    bool Mesh::HasIndexChanges() const
+    {
+        return indicesChanged;
+    }
+    // En: Marks the mesh as uploaded.
+    // Tr: Meshi yüklenmiş olarak işaretler.
+    void Mesh::ClearChanges()
+    {
+        changedBegin = changedEnd = 0;
+        indicesChanged = false;
+    }
+    void Mesh::SetDynamic(bool dynamic)
+    {
+        this->dynamic = dynamic;
+    }
+    bool Mesh::IsDynamic() const
+    {
+        return dynamic;
+    }
+    void Mesh::SetShader(Shader *shader)
+    {
+        this->shader = shader;
+    }
+    Shader *Mesh::GetShader() const
+    {
+        return shader;
     }
     // En: Returns the indices of the mesh.
     // `size` is the size of the indices.
@@ -284,29 +528,30 @@ namespace parseShape
 
     Mesh *CreateBox(float width, float height, float depth, int vertexSize)
     {
-        Mesh *mesh = new Mesh(8, vertexSize);
+        MeshBuilder builder(vertexSize);
+        builder.Reserve(8, 36);
 
         float halfWidth = width / 2.0f;
         float halfHeight = height / 2.0f;
         float halfDepth = depth / 2.0f;
 
-        mesh->ChangeVertex(glm::vec3(-halfWidth, -halfHeight, -halfDepth), 0, 0);
-        mesh->ChangeVertex(glm::vec3(halfWidth, -halfHeight, -halfDepth), 1, 0);
-        mesh->ChangeVertex(glm::vec3(halfWidth, halfHeight, -halfDepth), 2, 0);
-        mesh->ChangeVertex(glm::vec3(-halfWidth, halfHeight, -halfDepth), 3, 0);
-        mesh->ChangeVertex(glm::vec3(-halfWidth, -halfHeight, halfDepth), 4, 0);
-        mesh->ChangeVertex(glm::vec3(halfWidth, -halfHeight, halfDepth), 5, 0);
-        mesh->ChangeVertex(glm::vec3(halfWidth, halfHeight, halfDepth), 6, 0);
-        mesh->ChangeVertex(glm::vec3(-halfWidth, halfHeight, halfDepth), 7, 0);
+        builder.AddVertex(glm::vec3(-halfWidth, -halfHeight, -halfDepth));
+        builder.AddVertex(glm::vec3(halfWidth, -halfHeight, -halfDepth));
+        builder.AddVertex(glm::vec3(halfWidth, halfHeight, -halfDepth));
+        builder.AddVertex(glm::vec3(-halfWidth, halfHeight, -halfDepth));
+        builder.AddVertex(glm::vec3(-halfWidth, -halfHeight, halfDepth));
+        builder.AddVertex(glm::vec3(halfWidth, -halfHeight, halfDepth));
+        builder.AddVertex(glm::vec3(halfWidth, halfHeight, halfDepth));
+        builder.AddVertex(glm::vec3(-halfWidth, halfHeight, halfDepth));
 
-        mesh->SetIndices({2, 1, 0, 0, 3, 2,
-                          6, 5, 1, 1, 2, 6,
-                          7, 4, 5, 5, 6, 7,
-                          3, 0, 4, 4, 7, 3,
-                          6, 2, 3, 3, 7, 6,
-                          1, 5, 4, 4, 0, 1});
+        builder.SetIndices({2, 1, 0, 0, 3, 2,
+                            6, 5, 1, 1, 2, 6,
+                            7, 4, 5, 5, 6, 7,
+                            3, 0, 4, 4, 7, 3,
+                            6, 2, 3, 3, 7, 6,
+                            1, 5, 4, 4, 0, 1});
 
-        return mesh;
+        return builder.Build();
     }
     Mesh *CreateBox(float width, float height, float depth, Shader *shader)
     {
@@ -316,19 +561,20 @@ namespace parseShape
     }
     Mesh *CreatePlane(float width, float height, int vertexSize)
     {
-        Mesh *mesh = new Mesh(4, vertexSize);
+        MeshBuilder builder(vertexSize);
+        builder.Reserve(4, 6);
 
         float halfWidth = width / 2.0f;
         float halfHeight = height / 2.0f;
 
-        mesh->ChangeVertex(glm::vec3(-halfWidth, 0.0f, -halfHeight), 0, 0);
-        mesh->ChangeVertex(glm::vec3(halfWidth, 0.0f, -halfHeight), 1, 0);
-        mesh->ChangeVertex(glm::vec3(halfWidth, 0.0f, halfHeight), 2, 0);
-        mesh->ChangeVertex(glm::vec3(-halfWidth, 0.0f, halfHeight), 3, 0);
+        builder.AddVertex(glm::vec3(-halfWidth, 0.0f, -halfHeight));
+        builder.AddVertex(glm::vec3(halfWidth, 0.0f, -halfHeight));
+        builder.AddVertex(glm::vec3(halfWidth, 0.0f, halfHeight));
+        builder.AddVertex(glm::vec3(-halfWidth, 0.0f, halfHeight));
 
-        mesh->SetIndices({2, 1, 0, 0, 3, 2});
+        builder.SetIndices({2, 1, 0, 0, 3, 2});
 
-        return mesh;
+        return builder.Build();
     }
     Mesh *CreatePlane(float width, float height, Shader *shader)
     {
@@ -338,34 +584,38 @@ namespace parseShape
     }
     Mesh *CreateCylinder(float radius, float height, int sectorCount, int vertexSize)
     {
-        Mesh *mesh = new Mesh(sectorCount * 2, vertexSize);
+        MeshBuilder builder(vertexSize);
+        builder.Reserve((size_t)sectorCount * 2, (size_t)sectorCount * 6);
 
         float sectorStep = 2 * (22.0f / 7.0f) / sectorCount;
+        const std::vector<glm::vec2> &sinCos = GetSinCosTable(sectorCount, sectorStep);
 
-        for (int i = 0; i < sectorCount; i++)
+        // En: Both rings are written in one pass, the top ring starts `sectorCount` vertices after the bottom one.
+        // Tr: İki halka tek geçişte yazılır, üst halka alttakinden `sectorCount` vertex sonra başlar.
+        float *bottom = builder.AddVertices((size_t)sectorCount * 2), *top = bottom + (size_t)sectorCount * vertexSize;
+        for (int i = 0; i < sectorCount; i++, bottom += vertexSize, top += vertexSize)
         {
-            float sectorAngle = i * sectorStep;
-            float x = radius * cos(sectorAngle);
-            float z = radius * sin(sectorAngle);
-
-            mesh->ChangeVertex(glm::vec3(x, -height / 2.0f, z), i, 0);
-            mesh->ChangeVertex(glm::vec3(x, height / 2.0f, z), i + sectorCount, 0);
+            float x = radius * sinCos[i].x;
+            float z = radius * sinCos[i].y;
+            bottom[0] = top[0] = x;
+            bottom[1] = -height / 2.0f;
+            top[1] = height / 2.0f;
+            bottom[2] = top[2] = z;
         }
 
-        std::vector<unsigned int> indices;
-        for (int i = 0; i < sectorCount; i++)
+        unsigned int *index = builder.AddIndices((size_t)sectorCount * 6);
+        for (int i = 0; i < sectorCount; i++, index += 6)
         {
-            indices.push_back(i);
-            indices.push_back((i + 1) % sectorCount);
-            indices.push_back(i + sectorCount);
-
-            indices.push_back(i + sectorCount);
-            indices.push_back((i + 1) % sectorCount);
-            indices.push_back((i + 1) % sectorCount + sectorCount);
+            unsigned int next = (i + 1) % sectorCount;
+            index[0] = i;
+            index[1] = i + sectorCount;
+            index[2] = next;
+            index[3] = i + sectorCount;
+            index[4] = next + sectorCount;
+            index[5] = next;
         }
-        mesh->SetIndices(indices);
 
-        return mesh;
+        return builder.Build();
     }
     Mesh *CreateCylinder(float radius, float height, int sectorCount, Shader *shader)
     {
@@ -375,30 +625,30 @@ namespace parseShape
     }
     Mesh *CreateCone(float radius, float height, int sectorCount, int vertexSize)
     {
-        Mesh *mesh = new Mesh(sectorCount + 1, vertexSize);
+        MeshBuilder builder(vertexSize);
+        builder.Reserve((size_t)sectorCount + 1, (size_t)sectorCount * 3);
 
         float sectorStep = 2 * (22.0f / 7.0f) / sectorCount;
+        const std::vector<glm::vec2> &sinCos = GetSinCosTable(sectorCount, sectorStep);
 
-        for (int i = 0; i < sectorCount; i++)
+        float *vertex = builder.AddVertices((size_t)sectorCount + 1);
+        for (int i = 0; i < sectorCount; i++, vertex += vertexSize)
         {
-            float sectorAngle = i * sectorStep;
-            float x = radius * cos(sectorAngle);
-            float z = radius * sin(sectorAngle);
-
-            mesh->ChangeVertex(glm::vec3(x, -height / 2.0f, z), i, 0);
+            vertex[0] = radius * sinCos[i].x;
+            vertex[1] = -height / 2.0f;
+            vertex[2] = radius * sinCos[i].y;
         }
-        mesh->ChangeVertex(glm::vec3(0.0f, height / 2.0f, 0.0f), sectorCount, 0);
+        vertex[1] = height / 2.0f;
 
-        std::vector<unsigned int> indices;
-        for (int i = 0; i < sectorCount; i++)
+        unsigned int *index = builder.AddIndices((size_t)sectorCount * 3);
+        for (int i = 0; i < sectorCount; i++, index += 3)
         {
-            indices.push_back(i);
-            indices.push_back(sectorCount);
-            indices.push_back((i + 1) % sectorCount);
+            index[0] = i;
+            index[1] = sectorCount;
+            index[2] = (i + 1) % sectorCount;
         }
-        mesh->SetIndices(indices);
 
-        return mesh;
+        return builder.Build();
     }
     Mesh *CreateCone(float radius, float height, int sectorCount, Shader *shader)
     {
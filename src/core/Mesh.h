@@ -4,6 +4,7 @@
 #include "Object.h"
 #include "Shader.h"
 #include "Attribute.h"
+#include "Bounds.h"
 
 #include <vector>
 #include <map>
@@ -11,6 +12,16 @@
 
 namespace parseShape
 {
+    // En: A lower detail version of a mesh, it shares the vertices of the mesh.
+    // Tr: Bir meshin düşük detaylı hali, meshin vertex'lerini paylaşır.
+    struct MeshLOD
+    {
+        std::vector<unsigned int> indices;
+        // En: The level is used when the mesh covers less than this ratio of the screen height.
+        // Tr: Mesh ekran yüksekliğinin bu oranından azını kapladığında bu seviye kullanılır.
+        float screenSize;
+    };
+
     // En: Mesh class is used to create a mesh object with vertices and indices. Inherits from Object class.
     // Tr: Mesh sınıfı, bir mesh nesnesi oluşturmak için vertex ve index'leri kullanır. Object sınıfından türetilmiştir.
     class Mesh : public Object
@@ -18,13 +29,37 @@ namespace parseShape
     private:
         std::vector<float> vertices;
         std::vector<unsigned int> indices;
-        int vertexCount, vertexSize;
+        int vertexCount = 0, vertexSize = 0;
         AttributeTypeName attributeTypes;
         AttributeLocation attributeLocations;
         AttributeOffset attributeOffsets;
+        std::vector<MeshLOD> lods;
+
+        // En: Local bounds, they grow with added vertices and are only recalculated after a change that may shrink them.
+        // Tr: Yerel sınırlar, eklenen vertex'lerle büyür ve yalnızca onları küçültebilecek bir değişiklikten sonra yeniden hesaplanır.
+        mutable AABB bounds;
+        mutable BoundingSphere sphere;
+        mutable bool boundsDirty = true;
+
+        glm::vec3 PositionOf(int index) const;
+        void UpdateBounds() const;
+
+        // En: Vertices changed since the last ClearChanges, `changedEnd` is past the last changed vertex.
+        // Tr: Son ClearChanges'ten beri değişen vertex'ler, `changedEnd` son değişen vertex'in bir sonrasıdır.
+        unsigned int changedBegin = 0, changedEnd = 0;
+        bool indicesChanged = true;
+        bool dynamic = false;
+        Shader *shader = nullptr;
+
+        void MarkChanged(unsigned int begin, unsigned int end);
+        void ExpandBounds(size_t firstVertex);
+        void ChangeBounds(glm::vec3 previous, int index);
 
     public:
         Mesh(std::vector<float> vertices = {}, std::vector<unsigned int> indices = {});
+        // En: Takes over the buffers, pass them with std::move to avoid a copy.
+        // Tr: Buffer'ları devralır, kopyalamamak için std::move ile verin.
+        Mesh(std::vector<float> vertices, std::vector<unsigned int> indices, int vertexSize);
         Mesh(int vertexCount, int vertexSize);
         Mesh(int vertexCount, Shader *shader);
         ~Mesh();
@@ -32,13 +67,13 @@ namespace parseShape
         void Adapt(Shader *shader);
         // En: Adds vertices to the mesh.
         // Tr: Mesh'e vertex'ler ekler.
-        void AddVertex(std::vector<float> vertex);
+        void AddVertex(const std::vector<float> &vertex);
         // En: Adds vertices to the mesh.
         // Tr: Mesh'e vertex'ler ekler.
         void AddVertex(float *vertex, int size);
         // En: Adds indices to the mesh.
         // Tr: Mesh'e index'ler ekler.
-        void AddIndices(std::vector<unsigned int> indices);
+        void AddIndices(const std::vector<unsigned int> &indices);
         // En: Adds indices to the mesh.
         // Tr: Mesh'e index'ler ekler.
         void AddIndices(unsigned int *indices, int size);
@@ -60,6 +95,18 @@ namespace parseShape
         // En: Sets indices for the mesh.
         // Tr: Mesh için indisleri ayarlar.
         void SetIndices(std::vector<unsigned int> indices);
+        // En: Replaces all vertices of the mesh, the vertex size stays the same.
+        // Tr: Mesh'in tüm vertex'lerini değiştirir, vertex boyutu aynı kalır.
+        void SetVertices(std::vector<float> vertices);
+        // En: Adds a lower detail level, levels should be added from the most to the least detailed.
+        // Tr: Daha düşük detaylı bir seviye ekler, seviyeler en detaylıdan en az detaylıya doğru eklenmelidir.
+        void AddLOD(std::vector<unsigned int> indices, float screenSize);
+        void ClearLODs();
+        int GetLODCount() const;
+        const MeshLOD &GetLOD(int level) const;
+        // En: Returns the level to draw for the given screen size, 0 is the full detail mesh.
+        // Tr: Verilen ekran boyutu için çizilecek seviyeyi döndürür, 0 tam detaylı meshtir.
+        int SelectLOD(float screenSize) const;
         void DoTransformations(unsigned int begin, unsigned int offset);
         void DoTransformations() override;
 
@@ -79,8 +126,44 @@ namespace parseShape
         int GetVertexCount() const;
         int GetVertexSize() const;
 
+        // En: Bounds of the positions in mesh space.
+        // Tr: Mesh uzayındaki konumların sınırları.
+        AABB GetLocalBounds() const override;
+        BoundingSphere GetLocalSphere() const override;
+        // En: Rotation and scale are applied around the center of the local bounds.
+        // Tr: Dönme ve ölçek yerel sınırların merkezi etrafında uygulanır.
+        glm::vec3 GetPivot() const override;
+
         std::vector<float> GetVertices() const;
+        // En: Returns the raw vertex and index data without copying.
+        // Tr: Ham vertex ve index verisini kopyalamadan döndürür.
+        const std::vector<float> &GetVertexData() const;
+        const std::vector<unsigned int> &GetIndexData() const;
         float *GetVertices(int &size);
+        // En: Writes the vertices with the transform applied to the positions, every float is written once.
+        // `destination` must have room for every float of the mesh.
+        // Tr: Konumlara dönüşüm uygulanmış vertex'leri yazar, her float bir kez yazılır.
+        // `destination` meshin tüm float'ları için yer içermelidir.
+        void WriteVertices(float *destination) const;
+        // En: Writes the transformed vertices in [begin, end) to `destination`, which points to the place of vertex `begin`.
+        // If `normalOffset` is given, the three floats there are turned with the inverse transpose of the transform and normalized.
+        // Tr: [begin, end) aralığındaki dönüştürülmüş vertex'leri `begin` vertex'inin yerini gösteren `destination`'a yazar.
+        // `normalOffset` verilirse oradaki üç float dönüşümün ters devriği ile döndürülür ve normalize edilir.
+        void WriteVertices(float *destination, unsigned int begin, unsigned int end, int normalOffset = -1) const;
+
+        // En: Change tracking, the scene uploads only the vertices that changed since the last ClearChanges.
+        // Tr: Değişiklik takibi, sahne yalnızca son ClearChanges'ten beri değişen vertex'leri yükler.
+        bool GetChangedVertices(unsigned int &begin, unsigned int &end) const;
+        bool HasIndexChanges() const;
+        void ClearChanges();
+        // En: Dynamic meshes are streamed to the GPU every frame they change instead of living in the static buffer.
+        // Tr: Dinamik meshler statik buffer'da durmak yerine değiştikleri her karede GPU'ya akıtılır.
+        void SetDynamic(bool dynamic);
+        bool IsDynamic() const;
+        // En: The shader the mesh is drawn with, meshes without one use the shader of the scene.
+        // Tr: Meshin çizildiği shader, shader'ı olmayan meshler sahnenin shader'ını kullanır.
+        void SetShader(Shader *shader);
+        Shader *GetShader() const;
         unsigned int *GetIndices(int &size);
     };
 
@@ -0,0 +1,87 @@
+#ifndef MESH_BUILDER_CPP
+#define MESH_BUILDER_CPP
+
+#include "MeshBuilder.h"
+
+#include <utility>
+
+namespace parseShape
+{
+    MeshBuilder::MeshBuilder(int vertexSize)
+    {
+        this->vertexSize = vertexSize;
+    }
+    MeshBuilder::MeshBuilder(Shader *shader)
+    {
+        this->shader = shader;
+        vertexSize = shader ? shader->GetAttributeSize() : 3;
+    }
+
+    MeshBuilder &MeshBuilder::Reserve(size_t vertexCount, size_t indexCount)
+    {
+        vertices.reserve(vertexCount * vertexSize);
+        indices.reserve(indexCount);
+        return *this;
+    }
+    float *MeshBuilder::AddVertices(size_t count)
+    {
+        size_t first = vertices.size();
+        vertices.resize(first + count * vertexSize, 0.0f);
+        return vertices.data() + first;
+    }
+    unsigned int MeshBuilder::AddVertex(glm::vec3 position)
+    {
+        unsigned int index = GetVertexCount();
+        float *vertex = AddVertices(1);
+        for (int i = 0; i < 3 && i < vertexSize; i++)
+            vertex[i] = position[i];
+        return index;
+    }
+    MeshBuilder &MeshBuilder::AddTriangle(unsigned int a, unsigned int b, unsigned int c)
+    {
+        indices.push_back(a);
+        indices.push_back(b);
+        indices.push_back(c);
+        return *this;
+    }
+    unsigned int *MeshBuilder::AddIndices(size_t count)
+    {
+        size_t first = indices.size();
+        indices.resize(first + count);
+        return indices.data() + first;
+    }
+    MeshBuilder &MeshBuilder::SetVertices(std::vector<float> vertices)
+    {
+        this->vertices = std::move(vertices);
+        return *this;
+    }
+    MeshBuilder &MeshBuilder::SetIndices(std::vector<unsigned int> indices)
+    {
+        this->indices = std::move(indices);
+        return *this;
+    }
+
+    size_t MeshBuilder::GetVertexCount() const
+    {
+        return vertexSize > 0 ? vertices.size() / vertexSize : 0;
+    }
+    size_t MeshBuilder::GetIndexCount() const
+    {
+        return indices.size();
+    }
+    int MeshBuilder::GetVertexSize() const
+    {
+        return vertexSize;
+    }
+
+    Mesh *MeshBuilder::Build()
+    {
+        Mesh *mesh = new Mesh(std::move(vertices), std::move(indices), vertexSize);
+        if (shader)
+            mesh->Adapt(shader);
+        vertices.clear();
+        indices.clear();
+        return mesh;
+    }
+}
+#endif
\ No newline at end of file
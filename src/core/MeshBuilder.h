@@ -0,0 +1,58 @@
+#ifndef MESH_BUILDER_H
+#define MESH_BUILDER_H
+
+#include "Mesh.h"
+#include "Shader.h"
+
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+namespace parseShape
+{
+    // En : Collects the vertices and indices of a mesh and hands them to the mesh without copying.
+    // Reserve the exact counts up front when they are known, then write vertices in place with AddVertices.
+    // Tr : Bir meshin vertex ve index'lerini toplar ve onları meshe kopyalamadan verir.
+    // Sayılar biliniyorsa önceden tam olarak ayırın, sonra vertex'leri AddVertices ile yerinde yazın.
+    class MeshBuilder
+    {
+    private:
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        int vertexSize = 3;
+        Shader *shader = nullptr;
+
+    public:
+        MeshBuilder(int vertexSize = 3);
+        // En : The vertex size and the attributes of the mesh are taken from the shader.
+        // Tr : Vertex boyutu ve meshin attribute'ları shader'dan alınır.
+        MeshBuilder(Shader *shader);
+
+        // En : Reserves room for `vertexCount` vertices and `indexCount` indices.
+        // Tr : `vertexCount` vertex ve `indexCount` index için yer ayırır.
+        MeshBuilder &Reserve(size_t vertexCount, size_t indexCount);
+        // En : Appends `count` zeroed vertices and returns a pointer to the first one, the pointer is valid until the next append.
+        // Tr : `count` adet sıfırlanmış vertex ekler ve ilkinin adresini döndürür, adres bir sonraki eklemeye kadar geçerlidir.
+        float *AddVertices(size_t count);
+        // En : Appends a vertex with the position, the other attributes are zero. Returns the index of the vertex.
+        // Tr : Konumu verilen bir vertex ekler, diğer attribute'lar sıfırdır. Vertex'in index'ini döndürür.
+        unsigned int AddVertex(glm::vec3 position);
+        MeshBuilder &AddTriangle(unsigned int a, unsigned int b, unsigned int c);
+        // En : Appends `count` indices and returns a pointer to the first one, the pointer is valid until the next append.
+        // Tr : `count` adet index ekler ve ilkinin adresini döndürür, adres bir sonraki eklemeye kadar geçerlidir.
+        unsigned int *AddIndices(size_t count);
+        // En : Replaces the buffers with already filled ones, pass them with std::move to avoid a copy.
+        // Tr : Buffer'ları önceden doldurulmuş olanlarla değiştirir, kopyalamamak için std::move ile verin.
+        MeshBuilder &SetVertices(std::vector<float> vertices);
+        MeshBuilder &SetIndices(std::vector<unsigned int> indices);
+
+        size_t GetVertexCount() const;
+        size_t GetIndexCount() const;
+        int GetVertexSize() const;
+
+        // En : Moves the buffers into a new mesh, the builder is empty afterwards.
+        // Tr : Buffer'ları yeni bir meshe taşır, sonrasında builder boştur.
+        Mesh *Build();
+    };
+}
+#endif
\ No newline at end of file
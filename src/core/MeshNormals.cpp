@@ -0,0 +1,351 @@
+#ifndef MESH_NORMALS_CPP
+#define MESH_NORMALS_CPP
+
+#include "MeshNormals.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace parseShape
+{
+    namespace
+    {
+        // En : Unit normal of a triangle and the length of its cross product, which is twice its area.
+        // Tr : Bir üçgenin birim normali ve vektörel çarpımının uzunluğu, yani alanının iki katı.
+        struct FaceNormal
+        {
+            glm::vec3 direction = glm::vec3(0.0f);
+            float area = 0.0f;
+        };
+
+        // En : Corners that use each vertex, `corners[offsets[v]]` up to `corners[offsets[v + 1]]` belong to vertex v.
+        // A corner is a position in the index list, so its triangle is `corner / 3`.
+        // Tr : Her vertex'i kullanan köşeler, `corners[offsets[v]]` ile `corners[offsets[v + 1]]` arası v vertex'ine aittir.
+        // Köşe index listesindeki bir konumdur, bu yüzden üçgeni `corner / 3`'tür.
+        struct Adjacency
+        {
+            std::vector<unsigned int> offsets, corners;
+        };
+    }
+
+    static glm::vec3 ReadVec3(const float *vertices, unsigned int index, int vertexSize, int offset)
+    {
+        const float *v = vertices + (size_t)index * vertexSize + offset;
+        return glm::vec3(v[0], v[1], v[2]);
+    }
+    static bool IsValid(const std::vector<unsigned int> &indices, size_t triangle, unsigned int vertexCount)
+    {
+        return indices[triangle * 3] < vertexCount && indices[triangle * 3 + 1] < vertexCount && indices[triangle * 3 + 2] < vertexCount;
+    }
+
+    // En : Builds the vertex to corner lists without atomics, every thread owns a range of vertices and only writes their entries.
+    // Each thread reads the whole index list but never writes to memory another thread writes.
+    // Tr : Vertex'ten köşeye listeleri atomik işlem olmadan oluşturur, her thread bir vertex aralığına sahiptir ve yalnızca onların girdilerini yazar.
+    // Her thread tüm index listesini okur ama başka bir thread'in yazdığı belleğe asla yazmaz.
+    static Adjacency BuildAdjacency(const std::vector<unsigned int> &indices, unsigned int vertexCount)
+    {
+        Adjacency adjacency;
+        adjacency.offsets.assign((size_t)vertexCount + 1, 0);
+        const size_t triangleCount = indices.size() / 3;
+        const size_t partCount = std::min<size_t>(GetThreadCount(), std::max(1u, vertexCount));
+        const unsigned int partSize = (vertexCount + partCount - 1) / partCount;
+
+        ParallelFor(partCount, [&](size_t begin, size_t end)
+                    {
+                        for (size_t part = begin; part < end; part++)
+                        {
+                            unsigned int first = part * partSize, last = std::min<unsigned int>(first + partSize, vertexCount);
+                            for (size_t t = 0; t < triangleCount; t++)
+                            {
+                                if (!IsValid(indices, t, vertexCount))
+                                    continue;
+                                for (int k = 0; k < 3; k++)
+                                {
+                                    unsigned int v = indices[t * 3 + k];
+                                    if (v >= first && v < last)
+                                        adjacency.offsets[v + 1]++;
+                                }
+                            }
+                        } }, 1);
+
+        for (unsigned int v = 0; v < vertexCount; v++)
+            adjacency.offsets[v + 1] += adjacency.offsets[v];
+        adjacency.corners.resize(adjacency.offsets[vertexCount]);
+
+        ParallelFor(partCount, [&](size_t begin, size_t end)
+                    {
+                        for (size_t part = begin; part < end; part++)
+                        {
+                            unsigned int first = part * partSize, last = std::min<unsigned int>(first + partSize, vertexCount);
+                            if (first >= last)
+                                continue;
+                            std::vector<unsigned int> cursor(adjacency.offsets.begin() + first, adjacency.offsets.begin() + last);
+                            for (size_t t = 0; t < triangleCount; t++)
+                            {
+                                if (!IsValid(indices, t, vertexCount))
+                                    continue;
+                                for (int k = 0; k < 3; k++)
+                                {
+                                    unsigned int v = indices[t * 3 + k];
+                                    if (v >= first && v < last)
+                                        adjacency.corners[cursor[v - first]++] = t * 3 + k;
+                                }
+                            }
+                        } }, 1);
+        return adjacency;
+    }
+
+    // En : Calculates the normal of every triangle with the positions multiplied by `scale`, each thread writes only the
+    // triangles of its own batch.
+    // Tr : Konumlar `scale` ile çarpılmış olarak her üçgenin normalini hesaplar, her thread yalnızca kendi grubundaki
+    // üçgenleri yazar.
+    static std::vector<FaceNormal> CalculateFaceNormals(const std::vector<float> &vertices, int vertexSize, const std::vector<unsigned int> &indices, unsigned int vertexCount, glm::vec3 scale)
+    {
+        std::vector<FaceNormal> faces(indices.size() / 3);
+        ParallelFor(faces.size(), [&](size_t begin, size_t end)
+                    {
+                        for (size_t t = begin; t < end; t++)
+                        {
+                            if (!IsValid(indices, t, vertexCount))
+                                continue;
+                            glm::vec3 a = ReadVec3(vertices.data(), indices[t * 3], vertexSize, 0) * scale;
+                            glm::vec3 b = ReadVec3(vertices.data(), indices[t * 3 + 1], vertexSize, 0) * scale;
+                            glm::vec3 c = ReadVec3(vertices.data(), indices[t * 3 + 2], vertexSize, 0) * scale;
+                            glm::vec3 normal = glm::cross(b - a, c - a);
+                            float length = glm::length(normal);
+                            if (length > 0.0f)
+                            {
+                                faces[t].direction = normal / length;
+                                faces[t].area = length;
+                            }
+                        } });
+        return faces;
+    }
+
+    static glm::vec3 SafeNormalize(glm::vec3 v, glm::vec3 fallback)
+    {
+        float length = glm::length(v);
+        return length > 0.0f ? v / length : fallback;
+    }
+
+    // En : Generates smooth normals, every vertex gathers the normals of its own faces instead of faces scattering into vertices.
+    // Tr : Yumuşak normaller üretir, yüzlerin vertex'lere dağıtması yerine her vertex kendi yüzlerinin normallerini toplar.
+    void GenerateNormals(Mesh *mesh, float creaseAngle, int normalOffset)
+    {
+        if (!mesh)
+            return;
+        const int vertexSize = mesh->GetVertexSize();
+        const std::vector<float> &vertices = mesh->GetVertexData();
+        const std::vector<unsigned int> &indices = mesh->GetIndexData();
+        if (vertexSize < 3 || normalOffset < 0 || normalOffset + 3 > vertexSize || vertices.size() < (size_t)vertexSize)
+            return;
+
+        const unsigned int vertexCount = vertices.size() / vertexSize;
+        const size_t triangleCount = indices.size() / 3;
+        // En : Primitives keep their size in the scale of the mesh, so the faces and the crease angles are measured on the scaled
+        // shape. The normals are moved back into mesh space, the inverse transpose of the transform turns them back when drawn.
+        // Tr : Primitifler boyutlarını meshin ölçeğinde tutar, bu yüzden yüzler ve kırılma açıları ölçeklenmiş şekil üzerinde ölçülür.
+        // Normaller mesh uzayına geri taşınır, çizilirken dönüşümün ters devriği onları geri döndürür.
+        glm::vec3 scale = mesh->GetScale();
+        if (scale.x == 0.0f || scale.y == 0.0f || scale.z == 0.0f)
+            scale = glm::vec3(1.0f);
+        const std::vector<FaceNormal> faces = CalculateFaceNormals(vertices, vertexSize, indices, vertexCount, scale);
+        const Adjacency adjacency = BuildAdjacency(indices, vertexCount);
+        const bool smooth = creaseAngle >= 180.0f;
+        const float creaseCos = std::cos(glm::radians(std::max(creaseAngle, 0.0f)));
+
+        // En : Every corner gets the area weighted sum of the faces around its vertex that are within the crease angle of its own face.
+        // Corners with the same normal form a group, every group becomes one output vertex.
+        // Tr : Her köşe, vertex'i etrafındaki yüzlerden kendi yüzüne kırılma açısı içinde olanların alan ağırlıklı toplamını alır.
+        // Aynı normale sahip köşeler bir grup oluşturur, her grup bir çıkış vertex'i olur.
+        std::vector<glm::vec3> cornerNormals(indices.size(), glm::vec3(0.0f));
+        std::vector<unsigned int> cornerGroups(indices.size(), 0), groupCounts((size_t)vertexCount + 1, 0);
+        ParallelFor(vertexCount, [&](size_t begin, size_t end)
+                    {
+                        for (size_t v = begin; v < end; v++)
+                        {
+                            const unsigned int first = adjacency.offsets[v], last = adjacency.offsets[v + 1];
+                            groupCounts[v + 1] = 1;
+                            if (first == last)
+                                continue;
+                            if (smooth)
+                            {
+                                glm::vec3 sum(0.0f);
+                                for (unsigned int i = first; i < last; i++)
+                                {
+                                    const FaceNormal &face = faces[adjacency.corners[i] / 3];
+                                    sum += face.direction * face.area;
+                                }
+                                cornerNormals[adjacency.corners[first]] = SafeNormalize(sum, glm::vec3(0.0f, 1.0f, 0.0f));
+                                continue;
+                            }
+
+                            unsigned int groups = 0;
+                            for (unsigned int i = first; i < last; i++)
+                            {
+                                const unsigned int corner = adjacency.corners[i];
+                                const FaceNormal &face = faces[corner / 3];
+                                if (face.area <= 0.0f)
+                                    continue;
+                                glm::vec3 sum(0.0f);
+                                for (unsigned int j = first; j < last; j++)
+                                {
+                                    const FaceNormal &other = faces[adjacency.corners[j] / 3];
+                                    if (glm::dot(face.direction, other.direction) >= creaseCos)
+                                        sum += other.direction * other.area;
+                                }
+                                glm::vec3 normal = SafeNormalize(sum, face.direction);
+
+                                unsigned int group = groups;
+                                for (unsigned int k = first; k < i; k++)
+                                {
+                                    const unsigned int previous = adjacency.corners[k];
+                                    if (faces[previous / 3].area > 0.0f && glm::dot(cornerNormals[previous], normal) > 0.99999f)
+                                    {
+                                        group = cornerGroups[previous];
+                                        break;
+                                    }
+                                }
+                                if (group == groups)
+                                    groups++;
+                                cornerGroups[corner] = group;
+                                cornerNormals[corner] = normal;
+                            }
+
+                            // En : Corners of degenerate faces have no direction of their own, they join the first group.
+                            // Tr : Dejenere yüzlerin köşelerinin kendi yönü yoktur, ilk gruba katılırlar.
+                            glm::vec3 firstNormal(0.0f, 1.0f, 0.0f);
+                            for (unsigned int i = first; i < last; i++)
+                                if (faces[adjacency.corners[i] / 3].area > 0.0f && cornerGroups[adjacency.corners[i]] == 0)
+                                {
+                                    firstNormal = cornerNormals[adjacency.corners[i]];
+                                    break;
+                                }
+                            for (unsigned int i = first; i < last; i++)
+                            {
+                                const unsigned int corner = adjacency.corners[i];
+                                if (faces[corner / 3].area <= 0.0f)
+                                {
+                                    cornerGroups[corner] = 0;
+                                    cornerNormals[corner] = firstNormal;
+                                }
+                            }
+                            groupCounts[v + 1] = std::max(groups, 1u);
+                        } });
+
+        for (unsigned int v = 0; v < vertexCount; v++)
+            groupCounts[v + 1] += groupCounts[v];
+        const std::vector<unsigned int> &bases = groupCounts;
+
+        // En : Every vertex writes its own copies and the indices of its own corners, so no two threads write the same memory.
+        // Tr : Her vertex kendi kopyalarını ve kendi köşelerinin index'lerini yazar, böylece iki thread aynı belleğe yazmaz.
+        std::vector<float> result((size_t)bases[vertexCount] * vertexSize);
+        std::vector<unsigned int> resultIndices(indices.size());
+        ParallelFor(vertexCount, [&](size_t begin, size_t end)
+                    {
+                        for (size_t v = begin; v < end; v++)
+                        {
+                            const unsigned int base = bases[v], count = bases[v + 1] - base;
+                            const float *source = vertices.data() + v * vertexSize;
+                            for (unsigned int g = 0; g < count; g++)
+                                std::copy(source, source + vertexSize, result.data() + (size_t)(base + g) * vertexSize);
+                            for (unsigned int i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; i++)
+                            {
+                                const unsigned int corner = adjacency.corners[i];
+                                const unsigned int group = smooth ? 0 : cornerGroups[corner];
+                                resultIndices[corner] = base + group;
+                                if (smooth && i != adjacency.offsets[v])
+                                    continue;
+                                float *normal = result.data() + (size_t)(base + group) * vertexSize + normalOffset;
+                                glm::vec3 value = SafeNormalize(cornerNormals[corner] * scale, cornerNormals[corner]);
+                                normal[0] = value.x;
+                                normal[1] = value.y;
+                                normal[2] = value.z;
+                            }
+                        } });
+
+        // En : Triangles that point outside the vertices were left out of the corner lists, they are removed here.
+        // Tr : Vertex'lerin dışını gösteren üçgenler köşe listelerine alınmamıştı, burada silinirler.
+        size_t kept = 0;
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            if (!IsValid(indices, t, vertexCount))
+                continue;
+            if (kept != t)
+                std::copy(resultIndices.begin() + t * 3, resultIndices.begin() + t * 3 + 3, resultIndices.begin() + kept * 3);
+            kept++;
+        }
+        resultIndices.resize(kept * 3);
+
+        mesh->SetVertices(std::move(result));
+        mesh->SetIndices(std::move(resultIndices));
+    }
+
+    void GenerateTangents(Mesh *mesh, int uvOffset, int tangentOffset, int tangentComponents, int normalOffset)
+    {
+        if (!mesh)
+            return;
+        const int vertexSize = mesh->GetVertexSize();
+        const std::vector<float> &vertices = mesh->GetVertexData();
+        const std::vector<unsigned int> &indices = mesh->GetIndexData();
+        tangentComponents = tangentComponents >= 4 ? 4 : 3;
+        if (vertexSize < 3 || uvOffset < 0 || uvOffset + 2 > vertexSize || tangentOffset < 0 || tangentOffset + tangentComponents > vertexSize ||
+            normalOffset < 0 || normalOffset + 3 > vertexSize || vertices.size() < (size_t)vertexSize)
+            return;
+
+        const unsigned int vertexCount = vertices.size() / vertexSize;
+        const float *data = vertices.data();
+
+        // En : Tangent and bitangent directions of every triangle, taken from how the texture coordinates change along its edges.
+        // Tr : Her üçgenin tanjant ve bitanjant yönleri, doku koordinatlarının kenarları boyunca nasıl değiştiğinden alınır.
+        std::vector<glm::vec3> tangents(indices.size() / 3, glm::vec3(0.0f)), bitangents(indices.size() / 3, glm::vec3(0.0f));
+        ParallelFor(tangents.size(), [&](size_t begin, size_t end)
+                    {
+                        for (size_t t = begin; t < end; t++)
+                        {
+                            if (!IsValid(indices, t, vertexCount))
+                                continue;
+                            unsigned int a = indices[t * 3], b = indices[t * 3 + 1], c = indices[t * 3 + 2];
+                            glm::vec3 edge1 = ReadVec3(data, b, vertexSize, 0) - ReadVec3(data, a, vertexSize, 0);
+                            glm::vec3 edge2 = ReadVec3(data, c, vertexSize, 0) - ReadVec3(data, a, vertexSize, 0);
+                            glm::vec2 uvA(data[(size_t)a * vertexSize + uvOffset], data[(size_t)a * vertexSize + uvOffset + 1]);
+                            glm::vec2 uv1 = glm::vec2(data[(size_t)b * vertexSize + uvOffset], data[(size_t)b * vertexSize + uvOffset + 1]) - uvA;
+                            glm::vec2 uv2 = glm::vec2(data[(size_t)c * vertexSize + uvOffset], data[(size_t)c * vertexSize + uvOffset + 1]) - uvA;
+                            float determinant = uv1.x * uv2.y - uv2.x * uv1.y;
+                            if (std::fabs(determinant) < 1e-12f)
+                                continue;
+                            float inverse = 1.0f / determinant;
+                            tangents[t] = (edge1 * uv2.y - edge2 * uv1.y) * inverse;
+                            bitangents[t] = (edge2 * uv1.x - edge1 * uv2.x) * inverse;
+                        } });
+
+        const Adjacency adjacency = BuildAdjacency(indices, vertexCount);
+        std::vector<float> result(vertices);
+        ParallelFor(vertexCount, [&](size_t begin, size_t end)
+                    {
+                        for (size_t v = begin; v < end; v++)
+                        {
+                            glm::vec3 tangent(0.0f), bitangent(0.0f);
+                            for (unsigned int i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; i++)
+                            {
+                                tangent += tangents[adjacency.corners[i] / 3];
+                                bitangent += bitangents[adjacency.corners[i] / 3];
+                            }
+                            glm::vec3 normal = SafeNormalize(ReadVec3(data, v, vertexSize, normalOffset), glm::vec3(0.0f, 1.0f, 0.0f));
+                            tangent -= normal * glm::dot(normal, tangent);
+                            glm::vec3 fallback = std::fabs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+                            tangent = SafeNormalize(tangent, glm::normalize(glm::cross(fallback, normal)));
+
+                            float *out = result.data() + v * vertexSize + tangentOffset;
+                            out[0] = tangent.x;
+                            out[1] = tangent.y;
+                            out[2] = tangent.z;
+                            if (tangentComponents == 4)
+                                out[3] = glm::dot(glm::cross(normal, tangent), bitangent) < 0.0f ? -1.0f : 1.0f;
+                        } });
+
+        mesh->SetVertices(std::move(result));
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef MESH_NORMALS_H
+#define MESH_NORMALS_H
+
+#include "Mesh.h"
+
+namespace parseShape
+{
+    // En : Generates area weighted smooth normals for the mesh on all threads.
+    // Corners whose faces bend more than `creaseAngle` degrees away from each other get separate vertices, 180 keeps every vertex smooth.
+    // `normalOffset` is the float offset of the normal in a vertex, the first three floats are the position.
+    // The shape is measured with the scale of the mesh applied, the normals are stored in mesh space.
+    // Triangles that point outside the vertices are removed.
+    // Tr : Mesh için alan ağırlıklı yumuşak normalleri tüm thread'lerde üretir.
+    // Yüzleri birbirinden `creaseAngle` dereceden fazla ayrılan köşeler ayrı vertex'ler alır, 180 her vertex'i yumuşak tutar.
+    // `normalOffset` normalin vertex içindeki float ofsetidir, ilk üç float konumdur.
+    // Şekil meshin ölçeği uygulanmış olarak ölçülür, normaller mesh uzayında saklanır.
+    // Vertex'lerin dışını gösteren üçgenler silinir.
+    void GenerateNormals(Mesh *mesh, float creaseAngle = 180.0f, int normalOffset = 3);
+    // En : Generates tangents from the texture coordinates, every vertex should already have a normal.
+    // The tangent is orthogonal to the normal, if `tangentComponents` is 4 the fourth float is the handedness of the bitangent.
+    // Tr : Doku koordinatlarından tanjantlar üretir, her vertex'in zaten bir normali olmalıdır.
+    // Tanjant normale diktir, `tangentComponents` 4 ise dördüncü float bitanjantın yönüdür.
+    void GenerateTangents(Mesh *mesh, int uvOffset, int tangentOffset, int tangentComponents = 4, int normalOffset = 3);
+}
+#endif
\ No newline at end of file
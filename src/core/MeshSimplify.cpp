@@ -0,0 +1,335 @@
+#ifndef MESH_SIMPLIFY_CPP
+#define MESH_SIMPLIFY_CPP
+
+#include "MeshSimplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace parseShape
+{
+    namespace
+    {
+        // En : Symmetric 4x4 matrix of a quadric error, stored as its upper triangle.
+        // Tr : Bir quadric hatasının simetrik 4x4 matrisi, üst üçgeni olarak saklanır.
+        struct Quadric
+        {
+            double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+            double b0 = 0, b1 = 0, b2 = 0, c = 0;
+        };
+        // En : Edge of a triangle, `a` is always the smaller index.
+        // Tr : Bir üçgenin kenarı, `a` her zaman küçük olan indekstir.
+        struct Edge
+        {
+            unsigned int a, b;
+            size_t triangle;
+        };
+        // En : Candidate edge collapse, `from` is moved onto `to`.
+        // Tr : Aday kenar birleştirmesi, `from` vertex'i `to` üzerine taşınır.
+        struct Collapse
+        {
+            unsigned int from, to;
+            float cost;
+        };
+    }
+
+    static void AddPlane(Quadric &q, glm::vec3 normal, float distance, float weight)
+    {
+        double x = normal.x, y = normal.y, z = normal.z, d = distance, w = weight;
+        q.a00 += w * x * x;
+        q.a01 += w * x * y;
+        q.a02 += w * x * z;
+        q.a11 += w * y * y;
+        q.a12 += w * y * z;
+        q.a22 += w * z * z;
+        q.b0 += w * x * d;
+        q.b1 += w * y * d;
+        q.b2 += w * z * d;
+        q.c += w * d * d;
+    }
+    static void AddQuadric(Quadric &q, const Quadric &other)
+    {
+        q.a00 += other.a00;
+        q.a01 += other.a01;
+        q.a02 += other.a02;
+        q.a11 += other.a11;
+        q.a12 += other.a12;
+        q.a22 += other.a22;
+        q.b0 += other.b0;
+        q.b1 += other.b1;
+        q.b2 += other.b2;
+        q.c += other.c;
+    }
+    static double Evaluate(const Quadric &q, glm::vec3 p)
+    {
+        double x = p.x, y = p.y, z = p.z;
+        double result = q.a00 * x * x + 2.0 * q.a01 * x * y + 2.0 * q.a02 * x * z +
+                        q.a11 * y * y + 2.0 * q.a12 * y * z + q.a22 * z * z +
+                        2.0 * (q.b0 * x + q.b1 * y + q.b2 * z) + q.c;
+        return result > 0.0 ? result : 0.0;
+    }
+
+    // En : Simplifies the given indices, see the header for the parameters.
+    // Tr : Verilen index'leri sadeleştirir, parametreler için başlık dosyasına bakın.
+    std::vector<unsigned int> Simplify(const std::vector<float> &vertices, int vertexSize, const std::vector<unsigned int> &indices,
+                                       size_t targetIndexCount, float attributeWeight, float maxError, float *resultError)
+    {
+        std::vector<unsigned int> result(indices.begin(), indices.begin() + indices.size() / 3 * 3);
+        if (resultError)
+            *resultError = 0.0f;
+        if (vertexSize < 3 || result.size() <= targetIndexCount)
+            return result;
+
+        const size_t vertexCount = vertices.size() / vertexSize;
+        for (unsigned int index : result)
+            if (index >= vertexCount)
+                return result;
+
+        // En : Positions are normalized so errors do not depend on the size of the mesh.
+        // Tr : Hatalar meshin boyutuna bağlı olmasın diye konumlar normalize edilir.
+        glm::vec3 min(std::numeric_limits<float>::max()), max(-std::numeric_limits<float>::max());
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            glm::vec3 p(vertices[i * vertexSize], vertices[i * vertexSize + 1], vertices[i * vertexSize + 2]);
+            min = glm::min(min, p);
+            max = glm::max(max, p);
+        }
+        glm::vec3 extent = max - min;
+        float largest = std::max(extent.x, std::max(extent.y, extent.z));
+        float scale = largest > 0.0f ? 1.0f / largest : 1.0f;
+
+        std::vector<glm::vec3> positions(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++)
+            positions[i] = (glm::vec3(vertices[i * vertexSize], vertices[i * vertexSize + 1], vertices[i * vertexSize + 2]) - min) * scale;
+
+        // En : Every vertex starts with the area weighted planes of its triangles.
+        // Tr : Her vertex, üçgenlerinin alan ağırlıklı düzlemleriyle başlar.
+        std::vector<Quadric> quadrics(vertexCount);
+        std::vector<Edge> edges;
+        edges.reserve(result.size());
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            unsigned int t[3] = {result[i], result[i + 1], result[i + 2]};
+            glm::vec3 normal = glm::cross(positions[t[1]] - positions[t[0]], positions[t[2]] - positions[t[0]]);
+            float length = glm::length(normal);
+            if (length <= 0.0f)
+                continue;
+            normal /= length;
+            float distance = -glm::dot(normal, positions[t[0]]);
+            for (int k = 0; k < 3; k++)
+            {
+                AddPlane(quadrics[t[k]], normal, distance, length * 0.5f);
+                edges.push_back({std::min(t[k], t[(k + 1) % 3]), std::max(t[k], t[(k + 1) % 3]), i});
+            }
+        }
+
+        // En : Border edges get a perpendicular plane so open borders keep their shape.
+        // Tr : Açık kenarlar şeklini korusun diye sınır kenarlarına dik bir düzlem eklenir.
+        std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b)
+                  { return a.a != b.a ? a.a < b.a : a.b < b.b; });
+        for (size_t i = 0; i < edges.size();)
+        {
+            size_t j = i + 1;
+            while (j < edges.size() && edges[j].a == edges[i].a && edges[j].b == edges[i].b)
+                j++;
+            if (j - i == 1)
+            {
+                size_t triangle = edges[i].triangle;
+                const glm::vec3 &a = positions[edges[i].a], &b = positions[edges[i].b];
+                glm::vec3 faceNormal = glm::cross(positions[result[triangle + 1]] - positions[result[triangle]],
+                                                  positions[result[triangle + 2]] - positions[result[triangle]]);
+                glm::vec3 normal = glm::cross(b - a, faceNormal);
+                float length = glm::length(normal);
+                if (length > 0.0f)
+                {
+                    normal /= length;
+                    float weight = glm::dot(b - a, b - a) * 10.0f;
+                    AddPlane(quadrics[edges[i].a], normal, -glm::dot(normal, a), weight);
+                    AddPlane(quadrics[edges[i].b], normal, -glm::dot(normal, a), weight);
+                }
+            }
+            i = j;
+        }
+
+        auto attributeCost = [&](unsigned int a, unsigned int b)
+        {
+            float cost = 0.0f;
+            for (int k = 3; k < vertexSize; k++)
+            {
+                float difference = vertices[a * vertexSize + k] - vertices[b * vertexSize + k];
+                cost += difference * difference;
+            }
+            return cost * attributeWeight;
+        };
+
+        const size_t targetTriangleCount = targetIndexCount / 3;
+        const float errorLimit = maxError * maxError;
+        size_t triangleCount = result.size() / 3;
+        float error = 0.0f;
+
+        std::vector<unsigned int> remap(vertexCount), triangleOffsets(vertexCount + 1), vertexTriangles;
+        std::vector<char> locked(vertexCount);
+        std::vector<Collapse> collapses;
+
+        for (int pass = 0; pass < 64 && triangleCount > targetTriangleCount; pass++)
+        {
+            // En : Triangles around each vertex, stored contiguously.
+            // Tr : Her vertex'in etrafındaki üçgenler, bitişik olarak saklanır.
+            std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+            for (unsigned int index : result)
+                triangleOffsets[index + 1]++;
+            for (size_t i = 0; i < vertexCount; i++)
+                triangleOffsets[i + 1] += triangleOffsets[i];
+            vertexTriangles.resize(result.size());
+            {
+                std::vector<unsigned int> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+                for (size_t i = 0; i < result.size(); i++)
+                    vertexTriangles[cursor[result[i]]++] = i / 3 * 3;
+            }
+
+            // En : Every unique edge is collapsed in the cheaper direction.
+            // Tr : Her benzersiz kenar daha ucuz olan yönde birleştirilir.
+            collapses.clear();
+            for (size_t i = 0; i < result.size(); i += 3)
+                for (int k = 0; k < 3; k++)
+                {
+                    unsigned int a = result[i + k], b = result[i + (k + 1) % 3];
+                    collapses.push_back({std::min(a, b), std::max(a, b), 0.0f});
+                }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b)
+                      { return a.from != b.from ? a.from < b.from : a.to < b.to; });
+            collapses.erase(std::unique(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b)
+                                        { return a.from == b.from && a.to == b.to; }),
+                            collapses.end());
+            for (Collapse &collapse : collapses)
+            {
+                unsigned int a = collapse.from, b = collapse.to;
+                float attributes = attributeCost(a, b);
+                double toB = Evaluate(quadrics[a], positions[b]) + Evaluate(quadrics[b], positions[b]);
+                double toA = Evaluate(quadrics[a], positions[a]) + Evaluate(quadrics[b], positions[a]);
+                if (toA < toB)
+                    collapse = {b, a, (float)toA + attributes};
+                else
+                    collapse = {a, b, (float)toB + attributes};
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b)
+                      { return a.cost < b.cost; });
+
+            for (size_t i = 0; i < vertexCount; i++)
+                remap[i] = i;
+            std::fill(locked.begin(), locked.end(), 0);
+
+            size_t removed = 0, budget = triangleCount - targetTriangleCount, collapsed = 0;
+            for (const Collapse &collapse : collapses)
+            {
+                if (collapse.cost > errorLimit || removed >= budget)
+                    break;
+                if (locked[collapse.from] || locked[collapse.to])
+                    continue;
+
+                // En : Skip collapses that flip a remaining triangle.
+                // Tr : Kalan bir üçgeni ters çeviren birleştirmeler atlanır.
+                bool flips = false;
+                size_t collapsedTriangles = 0;
+                for (unsigned int t = triangleOffsets[collapse.from]; t < triangleOffsets[collapse.from + 1] && !flips; t++)
+                {
+                    unsigned int triangle = vertexTriangles[t];
+                    unsigned int v[3] = {result[triangle], result[triangle + 1], result[triangle + 2]};
+                    if (v[0] == collapse.to || v[1] == collapse.to || v[2] == collapse.to)
+                    {
+                        collapsedTriangles++;
+                        continue;
+                    }
+                    glm::vec3 p[3] = {positions[v[0]], positions[v[1]], positions[v[2]]};
+                    glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    for (int k = 0; k < 3; k++)
+                        if (v[k] == collapse.from)
+                            p[k] = positions[collapse.to];
+                    glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    flips = glm::dot(before, after) <= 0.0f;
+                }
+                if (flips)
+                    continue;
+
+                remap[collapse.from] = collapse.to;
+                AddQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+                for (unsigned int vertex : {collapse.from, collapse.to})
+                    for (unsigned int t = triangleOffsets[vertex]; t < triangleOffsets[vertex + 1]; t++)
+                    {
+                        locked[result[vertexTriangles[t]]] = 1;
+                        locked[result[vertexTriangles[t] + 1]] = 1;
+                        locked[result[vertexTriangles[t] + 2]] = 1;
+                    }
+
+                error = std::max(error, collapse.cost);
+                removed += collapsedTriangles;
+                collapsed++;
+            }
+            if (!collapsed)
+                break;
+
+            size_t write = 0;
+            for (size_t i = 0; i < result.size(); i += 3)
+            {
+                unsigned int a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+                if (a == b || b == c || a == c)
+                    continue;
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+            result.resize(write);
+            triangleCount = result.size() / 3;
+        }
+
+        if (resultError)
+            *resultError = std::sqrt(error);
+        return result;
+    }
+    // En : Simplifies the mesh down to `ratio` of its triangles.
+    // `mesh` is the mesh to simplify, it is not changed.
+    // `ratio` is the wanted ratio of the triangle count between 0 and 1.
+    // Tr : Meshi üçgenlerinin `ratio` oranına kadar sadeleştirir.
+    // `mesh` sadeleştirilecek meshtir, değiştirilmez.
+    // `ratio` 0 ile 1 arasında istenen üçgen sayısı oranıdır.
+    std::vector<unsigned int> Simplify(const Mesh *mesh, float ratio, float attributeWeight, float *resultError)
+    {
+        if (!mesh)
+            return {};
+        const std::vector<unsigned int> &indices = mesh->GetIndexData();
+        size_t target = (size_t)(indices.size() / 3 * glm::clamp(ratio, 0.0f, 1.0f)) * 3;
+        return Simplify(mesh->GetVertexData(), mesh->GetVertexSize(), indices, target, attributeWeight, 1.0f, resultError);
+    }
+    // En : Builds the LOD chain of the mesh.
+    // `levelCount` is the maximum number of levels after the full detail mesh.
+    // `ratio` is the triangle ratio between two following levels.
+    // `screenSize` is the screen height ratio that the first level starts at.
+    // Tr : Meshin LOD zincirini oluşturur.
+    // `levelCount` tam detaylı meshten sonraki en fazla seviye sayısıdır.
+    // `ratio` ardışık iki seviye arasındaki üçgen oranıdır.
+    // `screenSize` ilk seviyenin başladığı ekran yüksekliği oranıdır.
+    int BuildLODs(Mesh *mesh, int levelCount, float ratio, float screenSize, float attributeWeight)
+    {
+        if (!mesh)
+            return 0;
+        mesh->ClearLODs();
+
+        std::vector<unsigned int> current = mesh->GetIndexData();
+        int built = 0;
+        for (int i = 0; i < levelCount; i++)
+        {
+            size_t target = (size_t)(current.size() / 3 * glm::clamp(ratio, 0.0f, 1.0f)) * 3;
+            if (target < 3)
+                break;
+            std::vector<unsigned int> lod = Simplify(mesh->GetVertexData(), mesh->GetVertexSize(), current, target, attributeWeight);
+            if (lod.empty() || lod.size() > current.size() * 0.9f)
+                break;
+            current = lod;
+            mesh->AddLOD(std::move(lod), screenSize / (float)(1 << i));
+            built++;
+        }
+        return built;
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef MESH_SIMPLIFY_H
+#define MESH_SIMPLIFY_H
+
+#include "Mesh.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace parseShape
+{
+    // En : Reduces the triangle count of an indexed mesh with quadric error metric edge collapses.
+    // Vertices are collapsed onto existing vertices, so the result is a new index list over the same vertices.
+    // `vertices` is the interleaved vertex data, the first three floats of each vertex are the position.
+    // `targetIndexCount` is the wanted index count, the result may be larger if the error limit is hit.
+    // `attributeWeight` scales the cost of merging vertices with different non-position attributes.
+    // `maxError` is the largest allowed collapse error, relative to the mesh extent.
+    // `resultError` receives the reached error, relative to the mesh extent.
+    // Tr : Indeksli bir meshin üçgen sayısını quadric hata metriği ile kenar birleştirerek azaltır.
+    // Vertex'ler var olan vertex'lerin üzerine birleştirilir, bu yüzden sonuç aynı vertex'ler için yeni bir index listesidir.
+    // `vertices` iç içe geçmiş vertex verisidir, her vertex'in ilk üç float'ı konumdur.
+    // `targetIndexCount` istenen index sayısıdır, hata sınırına ulaşılırsa sonuç daha büyük olabilir.
+    // `attributeWeight` konum dışındaki attribute'ları farklı olan vertex'leri birleştirme maliyetini ölçekler.
+    // `maxError` izin verilen en büyük birleştirme hatasıdır, mesh boyutuna görelidir.
+    // `resultError` ulaşılan hatayı alır, mesh boyutuna görelidir.
+    std::vector<unsigned int> Simplify(const std::vector<float> &vertices, int vertexSize, const std::vector<unsigned int> &indices,
+                                       size_t targetIndexCount, float attributeWeight = 1.0f, float maxError = 1.0f, float *resultError = nullptr);
+    // En : Simplifies the mesh down to `ratio` of its triangles and returns the new indices.
+    // Tr : Meshi üçgenlerinin `ratio` oranına kadar sadeleştirir ve yeni index'leri döndürür.
+    std::vector<unsigned int> Simplify(const Mesh *mesh, float ratio, float attributeWeight = 1.0f, float *resultError = nullptr);
+    // En : Builds a LOD chain for the mesh, each level keeps `ratio` of the previous level's triangles.
+    // Level i is drawn when the mesh covers less than `screenSize` / 2^(i - 1) of the screen height.
+    // Stops early when a level can not be reduced anymore. Returns the number of levels built.
+    // Tr : Mesh için bir LOD zinciri oluşturur, her seviye bir önceki seviyenin üçgenlerinin `ratio` oranını tutar.
+    // i. seviye, mesh ekran yüksekliğinin `screenSize` / 2^(i - 1) oranından azını kapladığında çizilir.
+    // Bir seviye daha fazla azaltılamadığında erken durur. Oluşturulan seviye sayısını döndürür.
+    int BuildLODs(Mesh *mesh, int levelCount = 3, float ratio = 0.5f, float screenSize = 0.25f, float attributeWeight = 1.0f);
+}
+#endif
\ No newline at end of file
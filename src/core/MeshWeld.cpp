@@ -0,0 +1,184 @@
+#ifndef MESH_WELD_CPP
+#define MESH_WELD_CPP
+
+#include "MeshWeld.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace parseShape
+{
+    static const unsigned int emptyBucket = std::numeric_limits<unsigned int>::max();
+    // En : Largest cell coordinate that still fits into a long long with room for the neighbour offsets.
+    // Tr : Komşu ofsetleri için yer bırakarak hâlâ long long'a sığan en büyük hücre koordinatı.
+    static const float cellLimit = 1e18f;
+
+    // En : Hashes the integer coordinates of a grid cell.
+    // Tr : Izgara hücresinin tam sayı koordinatlarını hash'ler.
+    static size_t HashCell(long long x, long long y, long long z)
+    {
+        unsigned long long h = (unsigned long long)x * 0x9E3779B97F4A7C15ULL ^ (unsigned long long)y * 0xC2B2AE3D27D4EB4FULL ^ (unsigned long long)z * 0x165667B19E3779F9ULL;
+        return (size_t)(h ^ (h >> 32));
+    }
+    // En : Checks if every attribute of two vertices are within `epsilon`, NaN is never close to anything.
+    // An epsilon of 0 compares the bit patterns, so -0 and 0 stay apart.
+    // Tr : İki vertex'in tüm attribute'larının `epsilon` mesafesinde olup olmadığını kontrol eder, NaN hiçbir şeye yakın değildir.
+    // 0 epsilon bit desenlerini karşılaştırır, böylece -0 ve 0 ayrı kalır.
+    static bool IsClose(const float *a, const float *b, int vertexSize, float epsilon)
+    {
+        if (epsilon == 0.0f)
+            return std::memcmp(a, b, (size_t)vertexSize * sizeof(float)) == 0;
+        for (int i = 0; i < vertexSize; i++)
+            if (!(std::fabs(a[i] - b[i]) <= epsilon))
+                return false;
+        return true;
+    }
+
+    // En : Welds the vertices of the mesh.
+    // `mesh` is the mesh to weld, its first three floats are treated as the position.
+    // `epsilon` is the largest difference allowed between two attributes of merged vertices.
+    // Tr : Meshin vertex'lerini birleştirir.
+    // `mesh` birleştirilecek meshtir, ilk üç float konum olarak kabul edilir.
+    // `epsilon` birleştirilen vertex'lerin attribute'ları arasındaki izin verilen en büyük farktır.
+    WeldResult Weld(Mesh *mesh, float epsilon)
+    {
+        WeldResult result;
+        if (!mesh)
+            return result;
+
+        const int vertexSize = mesh->GetVertexSize();
+        const std::vector<float> &vertices = mesh->GetVertexData();
+        const std::vector<unsigned int> &indices = mesh->GetIndexData();
+        if (vertexSize < 3 || vertices.size() < (size_t)vertexSize)
+            return result;
+
+        const unsigned int vertexCount = vertices.size() / vertexSize;
+        result.vertexCountBefore = vertexCount;
+        result.triangleCountBefore = indices.size() / 3;
+        epsilon = std::max(epsilon, 0.0f);
+
+        // En : The cells are larger than epsilon, so most vertices only look into their own cell.
+        // Neighbour cells are visited only if the vertex is closer than epsilon to the cell border.
+        // Tr : Hücreler epsilon'dan büyüktür, böylece çoğu vertex yalnızca kendi hücresine bakar.
+        // Komşu hücrelere yalnızca vertex hücre sınırına epsilon'dan yakınsa bakılır.
+        float cellSize = epsilon * 8.0f;
+        if (cellSize <= 0.0f)
+        {
+            glm::vec3 min(std::numeric_limits<float>::max()), max(-std::numeric_limits<float>::max());
+            for (unsigned int i = 0; i < vertexCount; i++)
+            {
+                glm::vec3 p(vertices[i * vertexSize], vertices[i * vertexSize + 1], vertices[i * vertexSize + 2]);
+                if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z))
+                    continue;
+                min = glm::min(min, p);
+                max = glm::max(max, p);
+            }
+            glm::vec3 extent = max - min;
+            float largest = std::max(extent.x, std::max(extent.y, extent.z));
+            cellSize = largest > 0.0f && std::isfinite(largest) ? largest * 1e-4f : 1.0f;
+        }
+        const float inverseCellSize = 1.0f / cellSize;
+        const float margin = epsilon * inverseCellSize;
+
+        size_t tableSize = 1;
+        while (tableSize < (size_t)vertexCount * 2)
+            tableSize <<= 1;
+        const size_t tableMask = tableSize - 1;
+
+        std::vector<unsigned int> buckets(tableSize, emptyBucket), next, remap(vertexCount);
+        std::vector<float> welded;
+        next.reserve(vertexCount);
+        welded.reserve(vertices.size());
+        unsigned int uniqueCount = 0;
+
+        for (unsigned int i = 0; i < vertexCount; i++)
+        {
+            const float *vertex = &vertices[i * (size_t)vertexSize];
+            float f[3];
+            long long cell[3];
+            int low[3], high[3];
+            // En : Positions that are not finite or too far away have no cell, such vertices are left unwelded.
+            // Tr : Sonlu olmayan ya da çok uzaktaki konumların hücresi yoktur, bu vertex'ler birleştirilmeden bırakılır.
+            bool hashed = true;
+            for (int k = 0; k < 3; k++)
+            {
+                f[k] = vertex[k] * inverseCellSize;
+                if (!(std::fabs(f[k]) < cellLimit))
+                {
+                    hashed = false;
+                    break;
+                }
+                float base = std::floor(f[k]);
+                cell[k] = (long long)base;
+                low[k] = f[k] - base < margin ? -1 : 0;
+                high[k] = base + 1.0f - f[k] <= margin ? 1 : 0;
+            }
+
+            unsigned int found = emptyBucket;
+            if (hashed)
+                for (int dx = low[0]; dx <= high[0] && found == emptyBucket; dx++)
+                    for (int dy = low[1]; dy <= high[1] && found == emptyBucket; dy++)
+                        for (int dz = low[2]; dz <= high[2] && found == emptyBucket; dz++)
+                        {
+                            size_t bucket = HashCell(cell[0] + dx, cell[1] + dy, cell[2] + dz) & tableMask;
+                            for (unsigned int u = buckets[bucket]; u != emptyBucket; u = next[u])
+                            {
+                                if (IsClose(&welded[u * (size_t)vertexSize], vertex, vertexSize, epsilon))
+                                {
+                                    found = u;
+                                    break;
+                                }
+                            }
+                        }
+
+            if (found == emptyBucket)
+            {
+                found = uniqueCount++;
+                welded.insert(welded.end(), vertex, vertex + vertexSize);
+                if (hashed)
+                {
+                    size_t bucket = HashCell(cell[0], cell[1], cell[2]) & tableMask;
+                    next.push_back(buckets[bucket]);
+                    buckets[bucket] = found;
+                }
+                else
+                    next.push_back(emptyBucket);
+            }
+            remap[i] = found;
+        }
+
+        std::vector<unsigned int> weldedIndices;
+        weldedIndices.reserve(indices.size());
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount)
+                continue;
+            unsigned int a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+            if (a == b || b == c || a == c)
+                continue;
+            weldedIndices.push_back(a);
+            weldedIndices.push_back(b);
+            weldedIndices.push_back(c);
+        }
+
+        result.vertexCountAfter = uniqueCount;
+        result.triangleCountAfter = weldedIndices.size() / 3;
+        result.savedBytes = (vertices.size() - welded.size()) * sizeof(float) +
+                            (indices.size() - weldedIndices.size()) * sizeof(unsigned int);
+
+        welded.shrink_to_fit();
+        mesh->SetVertices(std::move(welded));
+        mesh->SetIndices(std::move(weldedIndices));
+
+        return result;
+    }
+    // En : Removes the exact duplicate vertices of the mesh.
+    // Tr : Meshin birebir aynı olan vertex'lerini siler.
+    WeldResult RemoveDuplicates(Mesh *mesh)
+    {
+        return Weld(mesh, 0.0f);
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef MESH_WELD_H
+#define MESH_WELD_H
+
+#include "Mesh.h"
+
+#include <cstddef>
+
+namespace parseShape
+{
+    // En : Holds how much a welding pass saved.
+    // Tr : Bir birleştirme işleminin ne kadar kazandırdığını tutar.
+    struct WeldResult
+    {
+        unsigned int vertexCountBefore = 0, vertexCountAfter = 0;
+        unsigned int triangleCountBefore = 0, triangleCountAfter = 0;
+        // En : Bytes freed from the vertex and index data.
+        // Tr : Vertex ve index verisinden kazanılan byte miktarı.
+        size_t savedBytes = 0;
+    };
+
+    // En : Merges vertices whose every attribute is within `epsilon` of each other and remaps the indices.
+    // Triangles that collapse after welding are removed. Runs in O(n) expected time using a spatial hash grid.
+    // An `epsilon` of 0 merges only vertices with the same bit patterns.
+    // Tr : Tüm attribute'ları birbirine `epsilon` mesafesinde olan vertex'leri birleştirir ve index'leri yeniden eşler.
+    // Birleştirme sonrası çöken üçgenler silinir. Uzamsal hash ızgarası ile beklenen O(n) sürede çalışır.
+    // 0 `epsilon` yalnızca bit desenleri aynı olan vertex'leri birleştirir.
+    WeldResult Weld(Mesh *mesh, float epsilon = 1e-6f);
+    // En : Same as Weld but only removes bit-exact duplicates.
+    // Tr : Weld ile aynıdır ancak yalnızca birebir aynı vertex'leri siler.
+    WeldResult RemoveDuplicates(Mesh *mesh);
+}
+#endif
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef OBJECT_CPP
 #define OBJECT_CPP
 #include "Object.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 namespace parseShape
 {
 #pragma region En : Constructors and Destructor Tr : Yapıcılar ve Yıkıcı
@@ -11,8 +14,126 @@ namespace parseShape
         this->scale = scale;
         this->up = up;
     }
+    Object::Object(const Object &other)
+    {
+        position = other.GetPosition();
+        rotation = other.GetRotation();
+        scale = other.GetScale();
+        up = other.up;
+    }
+    Object &Object::operator=(const Object &other)
+    {
+        glm::vec3 position = other.GetPosition(), scale = other.GetScale();
+        glm::quat rotation = other.GetRotation();
+        up = other.up;
+        SetPosition(position);
+        SetRotation(rotation);
+        SetScale(scale);
+        return *this;
+    }
+    // En : Children are detached and keep their local transform, so they are placed relative to the world afterwards.
+    // Tr : Çocuklar ayrılır ve yerel dönüşümlerini korur, böylece sonrasında dünyaya göre yerleştirilirler.
     Object::~Object()
     {
+        SetParent(nullptr);
+        for (auto child : children)
+        {
+            child->parent = nullptr;
+            child->InvalidateTransform();
+        }
+        if (store)
+            store->Destroy(handle);
+    }
+#pragma endregion
+#pragma region En : Hierarchy functions Tr : Hiyerarşi fonksiyonları
+    // En : Attaches the object to `parent`, the local transform is kept. A null parent detaches the object.
+    // Parents that would create a cycle are ignored.
+    // Tr : Nesneyi `parent`'a bağlar, yerel dönüşüm korunur. Null bir ebeveyn nesneyi ayırır.
+    // Döngü oluşturacak ebeveynler yok sayılır.
+    void Object::SetParent(Object *parent)
+    {
+        if (parent == this->parent)
+            return;
+        for (Object *ancestor = parent; ancestor; ancestor = ancestor->parent)
+            if (ancestor == this)
+                return;
+        if (this->parent)
+        {
+            std::vector<Object *> &siblings = this->parent->children;
+            siblings.erase(std::find(siblings.begin(), siblings.end(), this));
+        }
+        this->parent = parent;
+        if (parent)
+            parent->children.push_back(this);
+        if (parent && parent->store && parent->store != store)
+            AttachTo(parent->store);
+        else if (store)
+            store->SetParent(handle, parent && parent->store == store ? parent->handle : TransformHandle());
+        InvalidateTransform();
+    }
+    void Object::AddChild(Object *child)
+    {
+        if (child)
+            child->SetParent(this);
+    }
+    Object *Object::GetParent() const
+    {
+        return parent;
+    }
+    const std::vector<Object *> &Object::GetChildren() const
+    {
+        return children;
+    }
+    void Object::AttachTo(TransformStore *store)
+    {
+        if (store == this->store)
+            return;
+        glm::vec3 position = GetPosition(), scale = GetScale();
+        glm::quat rotation = GetRotation();
+        if (this->store)
+            this->store->Destroy(handle);
+        this->position = position;
+        this->rotation = rotation;
+        this->scale = scale;
+        this->store = store;
+        handle = TransformHandle();
+        if (store)
+        {
+            handle = store->Create(position, rotation, scale, this);
+            if (parent && parent->store == store)
+                store->SetParent(handle, parent->handle);
+        }
+        worldDirty = true;
+        for (auto child : children)
+        {
+            if (store && child->store == store)
+                store->SetParent(child->handle, handle);
+            else
+                child->AttachTo(store);
+        }
+    }
+    TransformStore *Object::GetTransformStore() const
+    {
+        return store;
+    }
+    TransformHandle Object::GetTransformHandle() const
+    {
+        return handle;
+    }
+    // En : Attached objects have no children outside their store, so only their own entry is marked.
+    // Tr : Bağlı nesnelerin depoları dışında çocukları yoktur, bu yüzden yalnızca kendi elemanları işaretlenir.
+    void Object::InvalidateTransform()
+    {
+        if (store)
+        {
+            store->Invalidate(handle);
+            return;
+        }
+        if (worldDirty)
+            return;
+        worldDirty = true;
+        for (auto child : children)
+            child->InvalidateTransform();
     }
 #pragma endregion
 #pragma region En : Transform functions Tr : Dönüşüm fonksiyonları
@@ -22,7 +143,7 @@ namespace parseShape
     // `translation` nesneyi öteleme vektörüdür.
     void Object::Translate(glm::vec3 translation)
     {
-        position += translation;
+        SetPosition(GetPosition() + translation);
     }
     // En: Rotates the object by the given quaternion.
     // `rotation` is the quaternion to rotate the object.
@@ -30,8 +151,7 @@ namespace parseShape
     // `rotation` nesneyi döndürmek için kullanılacak kuartyondur.
     void Object::Rotate(glm::quat rotation)
     {
-        this->rotation = rotation * this->rotation;
-        this->rotation = glm::normalize(this->rotation);
+        SetRotation(glm::normalize(rotation * GetRotation()));
     }
     // En: Scales the object by the given vector.
     // `scale` is the vector to scale the object.
@@ -39,7 +159,7 @@ namespace parseShape
     // `scale` nesneyi ölçeklendirmek için kullanılacak vektördür.
     void Object::Scale(glm::vec3 scale)
     {
-        this->scale *= scale;
+        SetScale(GetScale() * scale);
     }
     // En : Rotates the object to look at the target.
     // `target` is the position to look at.
@@ -47,7 +167,7 @@ namespace parseShape
     // `target` bakılacak konumdur.
     void Object::LookAt(glm::vec3 target)
     {
-        rotation = glm::quatLookAt(glm::normalize(target - position), up);
+        SetRotation(glm::quatLookAt(glm::normalize(target - GetPosition()), up));
     }
     // En : Sets the position of the object.
     // `position` is the position to set.
@@ -55,7 +175,13 @@ namespace parseShape
     // `position` ayarlanacak konumdur.
     void Object::SetPosition(glm::vec3 position)
     {
+        if (store)
+        {
+            store->SetPosition(handle, position);
+            return;
+        }
         this->position = position;
+        InvalidateTransform();
     }
     // En : Sets the rotation of the object.
     // `rotation` is the rotation to set.
@@ -63,7 +189,13 @@ namespace parseShape
     // `rotation` ayarlanacak dönüştür.
     void Object::SetRotation(glm::quat rotation)
     {
+        if (store)
+        {
+            store->SetRotation(handle, rotation);
+            return;
+        }
         this->rotation = rotation;
+        InvalidateTransform();
     }
     // En : Sets the scale of the object.
     // `scale` is the scale to set.
@@ -71,7 +203,13 @@ namespace parseShape
     // `scale` ayarlanacak ölçektir.
     void Object::SetScale(glm::vec3 scale)
     {
+        if (store)
+        {
+            store->SetScale(handle, scale);
+            return;
+        }
         this->scale = scale;
+        InvalidateTransform();
     }
     // En : Do transformations here after setting position, rotation and scale.
     // Should be overridden by derived classes.
@@ -86,37 +224,88 @@ namespace parseShape
     // Tr : Nesnenin konumunu verir.
     glm::vec3 Object::GetPosition() const
     {
-        return position;
+        return store ? store->GetPosition(handle) : position;
     }
     // En : Gives the rotation of the object.
     // Tr : Nesnenin dönüşünü verir.
     glm::quat Object::GetRotation() const
     {
-        return rotation;
+        return store ? store->GetRotation(handle) : rotation;
     }
     // En : Gives the scale of the object.
     // Tr : Nesnenin ölçeğini verir.
     glm::vec3 Object::GetScale() const
     {
-        return scale;
+        return store ? store->GetScale(handle) : scale;
     }
     // En : Gives the up vector of the object.
     // Tr : Nesnenin yukarı vektörünü verir.
     glm::vec3 Object::GetUp() const
     {
-        return glm::normalize(rotation * up);
+        return glm::normalize(GetRotation() * up);
     }
     // En : Gives the front vector of the object.
     // Tr : Nesnenin ön vektörünü verir.
     glm::vec3 Object::GetFront() const
     {
-        return glm::normalize(rotation * glm::vec3(0, 0, -1));
+        return glm::normalize(GetRotation() * glm::vec3(0, 0, -1));
     }
     // En : Gives the right vector of the object.
     // Tr : Nesnenin sağ vektörünü verir.
     glm::vec3 Object::GetRight() const
     {
-        return glm::normalize(rotation * glm::vec3(1, 0, 0));
+        return glm::normalize(GetRotation() * glm::vec3(1, 0, 0));
+    }
+#pragma endregion
+#pragma region En : Bounds Tr : Sınırlar
+    glm::vec3 Object::GetPivot() const
+    {
+        return glm::vec3(0.0f);
+    }
+    // En : Gives the matrix from the space of the object to the space of its parent.
+    // Tr : Nesnenin uzayından ebeveyninin uzayına matrisi verir.
+    glm::mat4 Object::GetLocalTransform() const
+    {
+        return store ? store->GetLocalMatrix(handle) : ComposeTransform(position, rotation, scale, GetPivot());
+    }
+    // En : Gives the local to world matrix of the object, only the stale part of the path to the root is recalculated.
+    // Reading it from several threads is only safe once it is not stale.
+    // Tr : Nesnenin yerelden dünyaya matrisini verir, köke giden yolun yalnızca eskimiş kısmı yeniden hesaplanır.
+    // Birden fazla thread'den okumak yalnızca eskimiş değilken güvenlidir.
+    glm::mat4 Object::GetTransform() const
+    {
+        if (store)
+            return parent && parent->store != store ? parent->GetTransform() * GetLocalTransform() : store->GetWorldMatrix(handle);
+        if (worldDirty)
+        {
+            world = parent ? parent->GetTransform() * GetLocalTransform() : GetLocalTransform();
+            worldDirty = false;
+        }
+        return world;
+    }
+    // En : Gives the bounds of the object in its own space, an object without geometry has empty bounds.
+    // Tr : Nesnenin kendi uzayındaki sınırlarını verir, geometrisi olmayan bir nesnenin sınırları boştur.
+    AABB Object::GetLocalBounds() const
+    {
+        return AABB();
+    }
+    // En : Gives the bounding sphere of the object in its own space.
+    // Tr : Nesnenin kendi uzayındaki sınır küresini verir.
+    BoundingSphere Object::GetLocalSphere() const
+    {
+        return BoundingSphere();
+    }
+    // En : Gives the world space box that contains the object.
+    // Tr : Nesneyi içeren dünya uzayındaki kutuyu verir.
+    AABB Object::GetWorldBounds() const
+    {
+        return GetLocalBounds().Transform(GetTransform());
+    }
+    // En : Gives the world space sphere that contains the object.
+    // Tr : Nesneyi içeren dünya uzayındaki küreyi verir.
+    BoundingSphere Object::GetWorldSphere() const
+    {
+        return GetLocalSphere().Transform(GetTransform());
     }
 #pragma endregion
 }
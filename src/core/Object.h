@@ -3,20 +3,67 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include "Bounds.h"
+#include "TransformStore.h"
+
+#include <vector>
+
 namespace parseShape
 {
     // En : This class is used to represent a 3D object in the scene.
+    // Position, rotation and scale are relative to the parent, the world matrix is cached and only
+    // recalculated after the object or one of its ancestors changed.
+    // An object attached to a transform store keeps its transform in the store instead and only holds a handle to it.
     // Tr : Bu sınıf, sahnedeki 3D nesneleri temsil etmek için kullanılır.
+    // Konum, dönüş ve ölçek ebeveyne görelidir, dünya matrisi önbelleğe alınır ve yalnızca
+    // nesne ya da atalarından biri değiştikten sonra yeniden hesaplanır.
+    // Bir dönüşüm deposuna bağlı nesne dönüşümünü bunun yerine depoda tutar ve yalnızca ona bir handle saklar.
     class Object
     {
+        friend class TransformStore;
+
+    private:
+        Object *parent = nullptr;
+        std::vector<Object *> children;
+        mutable glm::mat4 world = glm::mat4(1.0f);
+        mutable bool worldDirty = true;
+        TransformStore *store = nullptr;
+        TransformHandle handle;
+
     protected:
         glm::vec3 position = glm::vec3(), scale = glm::vec3(1.0f), up = glm::vec3(0, 1, 0);
         glm::quat rotation = glm::quat(1, 0, 0, 0);
 
+        // En : Marks the world matrix of the object and its descendants as stale, a stale object only has stale descendants.
+        // `position`, `rotation` and `scale` are only used while the object is not attached to a store.
+        // Tr : Nesnenin ve torunlarının dünya matrisini eskimiş olarak işaretler, eskimiş bir nesnenin yalnızca eskimiş torunları olur.
+        // `position`, `rotation` ve `scale` yalnızca nesne bir depoya bağlı değilken kullanılır.
+        void InvalidateTransform();
+
     public:
         Object() = default;
         Object(glm::vec3 position, glm::quat rotation, glm::vec3 scale, glm::vec3 up);
-        ~Object();
+        // En : Copies only the transform, the copy has no parent and no children.
+        // Tr : Yalnızca dönüşümü kopyalar, kopyanın ebeveyni ve çocukları yoktur.
+        Object(const Object &other);
+        Object &operator=(const Object &other);
+        virtual ~Object();
+
+        // En : Hierarchy functions
+        // Tr : Hiyerarşi fonksiyonları
+
+        void SetParent(Object *parent);
+        void AddChild(Object *child);
+        Object *GetParent() const;
+        const std::vector<Object *> &GetChildren() const;
+
+        // En : Moves the transforms of the object and its descendants into `store`, a null store moves them back into the objects.
+        // Objects attached under an attached parent join the store of the parent.
+        // Tr : Nesnenin ve torunlarının dönüşümlerini `store`'a taşır, null bir depo onları nesnelere geri taşır.
+        // Bağlı bir ebeveynin altına bağlanan nesneler ebeveynin deposuna katılır.
+        void AttachTo(TransformStore *store);
+        TransformStore *GetTransformStore() const;
+        TransformHandle GetTransformHandle() const;
 
         // En : Tranform functions
         // Tr : Dönüşüm fonksiyonları
@@ -39,6 +86,19 @@ namespace parseShape
         glm::vec3 GetUp() const;
         glm::vec3 GetFront() const;
         glm::vec3 GetRight() const;
+
+        // En : Bounds
+        // Tr : Sınırlar
+
+        // En : Returns the point in the space of the object it rotates and scales around.
+        // Tr : Nesnenin uzayında etrafında döndüğü ve ölçeklendiği noktayı döndürür.
+        virtual glm::vec3 GetPivot() const;
+        glm::mat4 GetLocalTransform() const;
+        glm::mat4 GetTransform() const;
+        virtual AABB GetLocalBounds() const;
+        virtual BoundingSphere GetLocalSphere() const;
+        AABB GetWorldBounds() const;
+        BoundingSphere GetWorldSphere() const;
     };
 }
 #endif
\ No newline at end of file
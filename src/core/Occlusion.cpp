@@ -0,0 +1,269 @@
+#ifndef OCCLUSION_CPP
+#define OCCLUSION_CPP
+
+#include "Occlusion.h"
+#include "Parallel.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+namespace parseShape
+{
+    namespace
+    {
+        // En : Rows rasterized by one task, every task walks all triangles so bands should not be too thin.
+        // Tr : Bir görevin rasterleştirdiği satırlar, her görev tüm üçgenleri dolaştığı için bantlar çok ince olmamalıdır.
+        const int bandHeight = 8;
+        const size_t boxBatch = 64;
+        const float minW = 1e-6f;
+
+        // En : Coefficients of `a * x + b * y + c`, positive inside the triangle.
+        // Tr : `a * x + b * y + c` katsayıları, üçgenin içinde pozitiftir.
+        struct EdgeFunction
+        {
+            float a, b, c;
+        };
+        // En : The constant is moved by half the extent of a pixel along the normal, so the function is non negative
+        // only at the centers of pixels that lie inside the edge completely.
+        // Tr : Sabit normal boyunca bir pikselin yarı boyutu kadar kaydırılır, böylece fonksiyon yalnızca tamamen
+        // kenarın içinde kalan piksellerin merkezlerinde negatif olmaz.
+        inline EdgeFunction CreateEdge(glm::vec3 from, glm::vec3 to)
+        {
+            EdgeFunction edge;
+            edge.a = from.y - to.y;
+            edge.b = to.x - from.x;
+            edge.c = -(edge.a * from.x + edge.b * from.y) - 0.5f * (std::fabs(edge.a) + std::fabs(edge.b));
+            return edge;
+        }
+    }
+
+#pragma region Constructors and Destructors
+    OcclusionBuffer::OcclusionBuffer(int width, int height)
+    {
+        Resize(width, height);
+    }
+#pragma endregion
+#pragma region Rendering
+    void OcclusionBuffer::Resize(int width, int height)
+    {
+        this->width = (std::max(width, 4) + 3) & ~3;
+        this->height = std::max(height, 1);
+        depth.assign((size_t)this->width * this->height, 1.0f);
+    }
+    void OcclusionBuffer::Clear(const glm::mat4 &viewProjection)
+    {
+        this->viewProjection = viewProjection;
+        std::fill(depth.begin(), depth.end(), 1.0f);
+        triangles.clear();
+    }
+    // En : Projects the triangles of the occluder, triangles that are behind the near plane, off screen or cover no full pixel
+    // get an empty row range.
+    // Tr : Örtenin üçgenlerini izdüşürür, yakın düzlemin arkasında, ekran dışında olan ya da hiçbir tam pikseli kaplamayan
+    // üçgenler boş bir satır aralığı alır.
+    void OcclusionBuffer::SetupTriangles(const Occluder &occluder, ScreenTriangle *destination) const
+    {
+        const Mesh *mesh = occluder.mesh;
+        const std::vector<float> &vertices = mesh->GetVertexData();
+        const std::vector<unsigned int> &indices = mesh->GetIndexData();
+        size_t stride = mesh->GetVertexSize(), vertexCount = mesh->GetVertexCount();
+        glm::mat4 matrix = viewProjection * occluder.transform;
+        std::vector<glm::vec4> clip(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            const float *vertex = &vertices[i * stride];
+            clip[i] = matrix * glm::vec4(vertex[0], vertex[1], vertex[2], 1.0f);
+        }
+        for (size_t triangle = 0; triangle < indices.size() / 3; triangle++)
+        {
+            ScreenTriangle &screen = destination[triangle];
+            screen.minY = 0;
+            screen.maxY = -1;
+            glm::vec2 low(FLT_MAX), high(-FLT_MAX);
+            bool valid = true;
+            for (int corner = 0; corner < 3 && valid; corner++)
+            {
+                unsigned int index = indices[triangle * 3 + corner];
+                if (index >= vertexCount)
+                {
+                    valid = false;
+                    break;
+                }
+                const glm::vec4 &point = clip[index];
+                valid = point.w > minW && point.z >= -point.w;
+                glm::vec3 projected = glm::vec3(point) / point.w;
+                screen.corners[corner] = glm::vec3((projected.x * 0.5f + 0.5f) * width, (projected.y * 0.5f + 0.5f) * height, projected.z);
+                low = glm::min(low, glm::vec2(screen.corners[corner]));
+                high = glm::max(high, glm::vec2(screen.corners[corner]));
+            }
+            if (!valid || high.x <= 0.0f || low.x >= width)
+                continue;
+            screen.minY = std::max((int)std::ceil(low.y), 0);
+            screen.maxY = std::min((int)std::floor(high.y) - 1, height - 1);
+        }
+    }
+    void OcclusionBuffer::Render(const std::vector<Occluder> &occluders)
+    {
+        std::vector<size_t> offsets(occluders.size() + 1, 0);
+        for (size_t i = 0; i < occluders.size(); i++)
+            offsets[i + 1] = offsets[i] + (occluders[i].mesh->GetVertexSize() >= 3 ? occluders[i].mesh->GetIndexData().size() / 3 : 0);
+        size_t first = triangles.size();
+        triangles.resize(first + offsets.back());
+        ParallelFor(occluders.size(), [&](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; i++)
+                            if (offsets[i + 1] > offsets[i])
+                                SetupTriangles(occluders[i], &triangles[first + offsets[i]]); }, 1);
+        int bands = (height + bandHeight - 1) / bandHeight;
+        ParallelFor(bands, [&](size_t begin, size_t end)
+                    { RasterizeRows(begin * bandHeight, std::min((int)end * bandHeight, height)); }, 1);
+        triangles.clear();
+    }
+    // En : Rasterizes the rows [begin, end) of every triangle, four pixels of a row are tested at once.
+    // The depth is the plane of the triangle moved to the far corner of the pixel and clamped to the farthest corner of the triangle.
+    // Tr : Her üçgenin [begin, end) satırlarını rasterleştirir, bir satırın dört pikseli aynı anda test edilir.
+    // Derinlik pikselin uzak köşesine kaydırılmış ve üçgenin en uzak köşesine sınırlanmış üçgen düzlemidir.
+    void OcclusionBuffer::RasterizeRows(int begin, int end)
+    {
+        for (const ScreenTriangle &triangle : triangles)
+        {
+            if (triangle.maxY < begin || triangle.minY >= end || triangle.minY > triangle.maxY)
+                continue;
+            glm::vec3 v0 = triangle.corners[0], v1 = triangle.corners[1], v2 = triangle.corners[2];
+            glm::vec2 d1 = glm::vec2(v1 - v0), d2 = glm::vec2(v2 - v0);
+            float area = d1.x * d2.y - d1.y * d2.x;
+            if (area == 0.0f)
+                continue;
+            if (area < 0.0f)
+            {
+                std::swap(v1, v2);
+                std::swap(d1, d2);
+                area = -area;
+            }
+            EdgeFunction edges[3] = {CreateEdge(v0, v1), CreateEdge(v1, v2), CreateEdge(v2, v0)};
+            float zx = ((v1.z - v0.z) * d2.y - (v2.z - v0.z) * d1.y) / area;
+            float zy = ((v2.z - v0.z) * d1.x - (v1.z - v0.z) * d2.x) / area;
+            float bias = 0.5f * (std::fabs(zx) + std::fabs(zy));
+            float farthest = std::max(v0.z, std::max(v1.z, v2.z));
+            float minX = std::min(v0.x, std::min(v1.x, v2.x)), maxX = std::max(v0.x, std::max(v1.x, v2.x));
+            int first = std::max((int)std::ceil(minX), 0) & ~3, last = std::min((int)std::floor(maxX) - 1, width - 1);
+            for (int y = std::max(begin, triangle.minY); y <= std::min(end - 1, triangle.maxY); y++)
+            {
+                float py = y + 0.5f;
+                float rows[3];
+                for (int i = 0; i < 3; i++)
+                    rows[i] = edges[i].b * py + edges[i].c;
+                float zRow = v0.z - zx * v0.x + zy * (py - v0.y) + bias;
+                float *row = &depth[(size_t)y * width];
+                int x = first;
+#ifdef PARSESHAPE_SSE2
+                const __m128 zero = _mm_setzero_ps(), lanes = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+                __m128 a0 = _mm_set1_ps(edges[0].a), a1 = _mm_set1_ps(edges[1].a), a2 = _mm_set1_ps(edges[2].a);
+                __m128 r0 = _mm_set1_ps(rows[0]), r1 = _mm_set1_ps(rows[1]), r2 = _mm_set1_ps(rows[2]);
+                __m128 slope = _mm_set1_ps(zx), start = _mm_set1_ps(zRow), limit = _mm_set1_ps(farthest);
+                for (; x <= last; x += 4)
+                {
+                    __m128 px = _mm_add_ps(_mm_set1_ps((float)x), lanes);
+                    __m128 inside = _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), r0), zero),
+                                               _mm_and_ps(_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), r1), zero),
+                                                          _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), r2), zero)));
+                    if (!_mm_movemask_ps(inside))
+                        continue;
+                    __m128 old = _mm_loadu_ps(row + x);
+                    __m128 z = _mm_min_ps(old, _mm_min_ps(_mm_add_ps(start, _mm_mul_ps(slope, px)), limit));
+                    _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, z), _mm_andnot_ps(inside, old)));
+                }
+#endif
+                for (; x <= last; x++)
+                {
+                    float px = x + 0.5f;
+                    if (edges[0].a * px + rows[0] < 0.0f || edges[1].a * px + rows[1] < 0.0f || edges[2].a * px + rows[2] < 0.0f)
+                        continue;
+                    row[x] = std::min(row[x], std::min(zRow + zx * px, farthest));
+                }
+            }
+        }
+    }
+#pragma endregion
+#pragma region Testing
+    // En : Returns true if a pixel of the rectangle is not nearer than `nearest`.
+    // Tr : Dikdörtgenin bir pikseli `nearest`'ten yakın değilse true döndürür.
+    bool OcclusionBuffer::IsRectVisible(int minX, int minY, int maxX, int maxY, float nearest) const
+    {
+        for (int y = minY; y <= maxY; y++)
+        {
+            const float *row = &depth[(size_t)y * width];
+            int x = minX;
+#ifdef PARSESHAPE_SSE2
+            __m128 limit = _mm_set1_ps(nearest);
+            for (; x + 3 <= maxX; x += 4)
+                if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), limit)))
+                    return true;
+#endif
+            for (; x <= maxX; x++)
+                if (row[x] >= nearest)
+                    return true;
+        }
+        return false;
+    }
+    bool OcclusionBuffer::IsVisible(const AABB &box) const
+    {
+        if (!box.IsValid())
+            return false;
+        glm::vec3 low(FLT_MAX), high(-FLT_MAX);
+        for (int corner = 0; corner < 8; corner++)
+        {
+            glm::vec3 point((corner & 1) ? box.max.x : box.min.x, (corner & 2) ? box.max.y : box.min.y, (corner & 4) ? box.max.z : box.min.z);
+            glm::vec4 clip = viewProjection * glm::vec4(point, 1.0f);
+            // En : A box reaching the near plane covers the camera, it can not be hidden.
+            // Tr : Yakın düzleme ulaşan bir kutu kamerayı kaplar, gizlenemez.
+            if (clip.w <= minW || clip.z < -clip.w)
+                return true;
+            glm::vec3 projected = glm::vec3(clip) / clip.w;
+            projected = glm::vec3((projected.x * 0.5f + 0.5f) * width, (projected.y * 0.5f + 0.5f) * height, projected.z);
+            low = glm::min(low, projected);
+            high = glm::max(high, projected);
+        }
+        if (high.x < 0.0f || high.y < 0.0f || low.x >= width || low.y >= height)
+            return false;
+        int minX = std::max((int)std::floor(low.x), 0), maxX = std::min((int)std::floor(high.x), width - 1);
+        int minY = std::max((int)std::floor(low.y), 0), maxY = std::min((int)std::floor(high.y), height - 1);
+        return IsRectVisible(minX, minY, maxX, maxY, low.z);
+    }
+    size_t OcclusionBuffer::CullBoxes(const BoxArray &boxes, std::vector<unsigned char> &visible) const
+    {
+        size_t count = boxes.Size();
+        visible.resize(count, 1);
+        ParallelFor(count, [&](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            if (!visible[i])
+                                continue;
+                            glm::vec3 center(boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i]);
+                            glm::vec3 extent(boxes.extentX[i], boxes.extentY[i], boxes.extentZ[i]);
+                            AABB box;
+                            box.min = center - extent;
+                            box.max = center + extent;
+                            visible[i] = IsVisible(box);
+                        } }, boxBatch);
+        return std::count(visible.begin(), visible.end(), 1);
+    }
+#pragma endregion
+#pragma region Getters
+    int OcclusionBuffer::GetWidth() const
+    {
+        return width;
+    }
+    int OcclusionBuffer::GetHeight() const
+    {
+        return height;
+    }
+    const std::vector<float> &OcclusionBuffer::GetDepth() const
+    {
+        return depth;
+    }
+#pragma endregion
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef OCCLUSION_H
+#define OCCLUSION_H
+
+#include "Mesh.h"
+#include "Bounds.h"
+#include "Frustum.h"
+
+#include <vector>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+namespace parseShape
+{
+    // En : A mesh rasterized into the occlusion buffer, `transform` takes its vertices to world space.
+    // Tr : Örtme buffer'ına rasterleştirilen bir mesh, `transform` vertex'lerini dünya uzayına taşır.
+    struct Occluder
+    {
+        const Mesh *mesh = nullptr;
+        glm::mat4 transform = glm::mat4(1.0f);
+    };
+
+    // En : Low resolution depth buffer rendered on the CPU, boxes hidden behind the occluders can be skipped before drawing.
+    // Occluders only write the pixels they cover completely, with their farthest depth inside the pixel, so a box is never
+    // reported hidden while a part of it is visible. Triangles crossing the near plane are left out for the same reason.
+    // Rasterization runs in bands of rows on the thread pool and the box tests are split between the threads as well.
+    // Tr : CPU'da çizilen düşük çözünürlüklü derinlik buffer'ı, örtenlerin arkasında gizli kutular çizimden önce atlanabilir.
+    // Örtenler yalnızca tamamen kapladıkları pikselleri piksel içindeki en uzak derinlikleri ile yazar, böylece bir kutu
+    // bir parçası görünürken asla gizli bildirilmez. Yakın düzlemi kesen üçgenler de aynı sebeple dışarıda bırakılır.
+    // Rasterleştirme thread havuzunda satır bantları halinde çalışır ve kutu testleri de thread'ler arasında bölünür.
+    class OcclusionBuffer
+    {
+    private:
+        // En : A triangle in pixel coordinates with its depth in normalized device coordinates.
+        // Tr : Piksel koordinatlarında, derinliği normalize cihaz koordinatlarında olan bir üçgen.
+        struct ScreenTriangle
+        {
+            glm::vec3 corners[3];
+            int minY = 0, maxY = -1;
+        };
+
+        int width = 0, height = 0;
+        std::vector<float> depth;
+        glm::mat4 viewProjection = glm::mat4(1.0f);
+        std::vector<ScreenTriangle> triangles;
+
+        void SetupTriangles(const Occluder &occluder, ScreenTriangle *destination) const;
+        void RasterizeRows(int begin, int end);
+        bool IsRectVisible(int minX, int minY, int maxX, int maxY, float nearest) const;
+
+    public:
+        // En : The width is rounded up to a multiple of four so rows are tested four pixels at once.
+        // Tr : Satırlar dört piksel birden test edilsin diye genişlik dördün katına yuvarlanır.
+        OcclusionBuffer(int width = 256, int height = 128);
+
+        void Resize(int width, int height);
+        // En : Clears the buffer to the far plane and sets the camera the occluders and boxes are projected with.
+        // Tr : Buffer'ı uzak düzleme temizler ve örtenlerin ve kutuların izdüşümünde kullanılan kamerayı ayarlar.
+        void Clear(const glm::mat4 &viewProjection);
+        // En : Rasterizes the triangles of the occluders, their full detail indices are used.
+        // Tr : Örtenlerin üçgenlerini rasterleştirir, tam detaylı index'leri kullanılır.
+        void Render(const std::vector<Occluder> &occluders);
+        // En : Returns false if the box is hidden behind the occluders or outside the screen.
+        // Tr : Kutu örtenlerin arkasında gizliyse ya da ekran dışındaysa false döndürür.
+        bool IsVisible(const AABB &box) const;
+        // En : Tests the boxes that are marked visible and clears the mark of the hidden ones.
+        // Returns the number of boxes that are still visible.
+        // Tr : Görünür işaretli kutuları test eder ve gizli olanların işaretini kaldırır.
+        // Hâlâ görünür olan kutuların sayısını döndürür.
+        size_t CullBoxes(const BoxArray &boxes, std::vector<unsigned char> &visible) const;
+
+        int GetWidth() const;
+        int GetHeight() const;
+        // En : Depth of every pixel row by row from the bottom, 1 is the far plane.
+        // Tr : Alttan başlayarak satır satır her pikselin derinliği, 1 uzak düzlemdir.
+        const std::vector<float> &GetDepth() const;
+    };
+}
+#endif
\ No newline at end of file
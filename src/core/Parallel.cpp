@@ -0,0 +1,129 @@
+#ifndef PARALLEL_CPP
+#define PARALLEL_CPP
+
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parseShape
+{
+    namespace
+    {
+        thread_local bool insideParallelFor = false;
+
+        // En : Worker threads sleep until a job is published, then take batches from a shared counter until it runs out.
+        // Tr : İşçi thread'ler bir iş yayınlanana kadar uyur, sonra ortak bir sayaçtan gruplar biter bitmez grup alır.
+        class ThreadPool
+        {
+        private:
+            std::vector<std::thread> workers;
+            std::mutex mutex, submit;
+            std::condition_variable wake, done;
+            const std::function<void(size_t, size_t)> *body = nullptr;
+            size_t count = 0, batchSize = 1;
+            std::atomic<size_t> next{0};
+            unsigned int active = 0;
+            unsigned long long generation = 0;
+            bool stop = false;
+
+            void Run()
+            {
+                size_t begin;
+                while ((begin = next.fetch_add(batchSize)) < count)
+                    (*body)(begin, std::min(begin + batchSize, count));
+            }
+            void Work()
+            {
+                insideParallelFor = true;
+                unsigned long long seen = 0;
+                while (true)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        wake.wait(lock, [&]()
+                                  { return stop || generation != seen; });
+                        if (stop)
+                            return;
+                        seen = generation;
+                    }
+                    Run();
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (--active == 0)
+                        done.notify_one();
+                }
+            }
+
+        public:
+            ThreadPool()
+            {
+                unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+                for (unsigned int i = 1; i < threads; i++)
+                    workers.emplace_back([this]()
+                                         { Work(); });
+            }
+            ~ThreadPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stop = true;
+                }
+                wake.notify_all();
+                for (auto &worker : workers)
+                    worker.join();
+            }
+            unsigned int GetThreadCount() const
+            {
+                return workers.size() + 1;
+            }
+            bool Dispatch(size_t count, const std::function<void(size_t, size_t)> &body, size_t batchSize)
+            {
+                std::unique_lock<std::mutex> submitLock(submit, std::try_to_lock);
+                if (!submitLock.owns_lock())
+                    return false;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    this->body = &body;
+                    this->count = count;
+                    this->batchSize = batchSize;
+                    next = 0;
+                    active = workers.size();
+                    generation++;
+                }
+                wake.notify_all();
+                insideParallelFor = true;
+                Run();
+                insideParallelFor = false;
+                std::unique_lock<std::mutex> lock(mutex);
+                done.wait(lock, [&]()
+                          { return active == 0; });
+                this->body = nullptr;
+                return true;
+            }
+        };
+
+        ThreadPool &GetThreadPool()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+    }
+
+    unsigned int GetThreadCount()
+    {
+        return GetThreadPool().GetThreadCount();
+    }
+    void ParallelFor(size_t count, const std::function<void(size_t, size_t)> &body, size_t batchSize)
+    {
+        if (count == 0)
+            return;
+        batchSize = std::max<size_t>(batchSize, 1);
+        if (count <= batchSize || insideParallelFor || GetThreadCount() == 1 || !GetThreadPool().Dispatch(count, body, batchSize))
+            body(0, count);
+    }
+}
+#endif
\ No newline at end of file
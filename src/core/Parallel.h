@@ -0,0 +1,22 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace parseShape
+{
+    // En : Returns the number of threads ParallelFor runs on, including the calling thread.
+    // Tr : ParallelFor'un üzerinde çalıştığı, çağıran thread dahil thread sayısını döndürür.
+    unsigned int GetThreadCount();
+    // En : Splits [0, count) into batches and runs `body` on them with a shared thread pool, the calling thread also takes batches.
+    // `body` receives the begin and end of a batch, batches never overlap so writing to per-item slots needs no locks.
+    // `batchSize` is the smallest number of items given to a thread at once.
+    // Runs serially on the calling thread if it is called from inside another ParallelFor or while the pool is busy.
+    // Tr : [0, count) aralığını gruplara böler ve `body`'yi ortak bir thread havuzu ile çalıştırır, çağıran thread de grup alır.
+    // `body` grubun başlangıcını ve sonunu alır, gruplar çakışmaz bu yüzden her elemanın kendi yerine yazmak kilit gerektirmez.
+    // `batchSize` bir thread'e tek seferde verilen en küçük eleman sayısıdır.
+    // Başka bir ParallelFor içinden ya da havuz meşgulken çağrılırsa çağıran thread üzerinde sırayla çalışır.
+    void ParallelFor(size_t count, const std::function<void(size_t, size_t)> &body, size_t batchSize = 1024);
+}
+#endif
\ No newline at end of file
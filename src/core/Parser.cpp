@@ -15,6 +15,65 @@ namespace parseShape
 {
     static simdjson::dom::parser parser;
     static Shader *globalShader = nullptr;
+
+    // En : Reads the property an animation track drives, returns false for an unknown name.
+    // Tr : Bir animasyon izinin sürdüğü özelliği okur, bilinmeyen bir isim için false döndürür.
+    static bool AnimationPropertyOf(std::string name, AnimationProperty &property)
+    {
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c)
+                       { return std::tolower(c); });
+        if (name == "position" || name == "translate")
+            property = AnimationProperty::Position;
+        else if (name == "rotation" || name == "rotate")
+            property = AnimationProperty::Rotation;
+        else if (name == "scale")
+            property = AnimationProperty::Scale;
+        else
+            return false;
+        return true;
+    }
+    // En : Returns the current value of the property, key components that are not given keep it. Rotations are Euler angles.
+    // Scale keys are factors of the parsed scale, since primitives keep their size in it, so their missing components are 1.
+    // Tr : Özelliğin güncel değerini döndürür, verilmeyen anahtar bileşenleri onu korur. Dönüşler Euler açılarıdır.
+    // Ölçek anahtarları ayrıştırılan ölçeğin çarpanlarıdır, çünkü primitifler boyutlarını onda tutar, bu yüzden eksik bileşenleri 1'dir.
+    static glm::vec3 AnimationBase(Object *object, AnimationProperty property)
+    {
+        switch (property)
+        {
+        case AnimationProperty::Rotation:
+            return glm::eulerAngles(object->GetRotation());
+        case AnimationProperty::Scale:
+            return glm::vec3(1.0f);
+        default:
+            return object->GetPosition();
+        }
+    }
+    // En : Fills the missing key components, sorts the keys by time and adds the tracks to the animator of the scene.
+    // Called after every modifier of the element was applied, scale keys are multiplied by the final scale.
+    // Tr : Eksik anahtar bileşenlerini doldurur, anahtarları zamana göre sıralar ve izleri sahnenin animatörüne ekler.
+    // Elemanın tüm değiştiricileri uygulandıktan sonra çağrılır, ölçek anahtarları son ölçekle çarpılır.
+    static void AddAnimations(Scene *scene, std::vector<ParsedAnimation> &animations)
+    {
+        for (auto &animation : animations)
+        {
+            AnimationTrack &track = animation.track;
+            std::vector<ParsedKey> &keys = animation.keys;
+            std::stable_sort(keys.begin(), keys.end(), [](const ParsedKey &a, const ParsedKey &b)
+                             { return a.time < b.time; });
+            glm::vec3 base = AnimationBase(track.target, track.property);
+            glm::vec3 scale = track.property == AnimationProperty::Scale ? track.target->GetScale() : glm::vec3(1.0f);
+            for (auto &key : keys)
+            {
+                glm::vec3 value = key.value;
+                for (int i = 0; i < 3; i++)
+                    if (!key.given[i])
+                        value[i] = base[i];
+                track.AddKey(key.time, value * scale);
+            }
+            scene->GetAnimator().AddTrack(track);
+        }
+        animations.clear();
+    }
     Scene *Parse(std::string path)
     {
         if (path.empty())
@@ -65,8 +124,30 @@ namespace parseShape
         Scene *Parse(simdjson::dom::element *element)
         {
             Scene *scene = new Scene();
+            // En : The first shader is the scene shader, meshes after a later one are drawn with it.
+            // Tr : İlk shader sahne shader'ıdır, sonraki bir shader'dan sonra gelen meshler onunla çizilir.
+            Shader *meshShader = nullptr;
 
-            for (auto field : (*element)["scene"].get_array())
+            if ((*element).at_key("quantize").error() == simdjson::SUCCESS)
+            {
+                std::string quantize((*element)["quantize"].get_string().value());
+                if (quantize == "half")
+                    scene->SetQuantized(true, VertexEncoding::Half);
+                else if (quantize == "snorm16" || quantize == "true")
+                    scene->SetQuantized(true, VertexEncoding::Snorm16);
+            }
+
+            Children((*element)["scene"].get_array(), scene, nullptr, meshShader);
+            return scene;
+        }
+
+        // En : Parses the objects of `fields`, meshes and groups can list nested objects under "children" which are attached to them.
+        // Cameras stay in world space. `meshShader` is the latest shader, it is shared with the nested lists.
+        // Tr : `fields` nesnelerini ayrıştırır, meshler ve gruplar "children" altında kendilerine bağlanan iç içe nesneler listeleyebilir.
+        // Kameralar dünya uzayında kalır. `meshShader` en son shader'dır, iç içe listelerle paylaşılır.
+        void Children(simdjson::dom::array fields, Scene *scene, Object *parent, Shader *&meshShader)
+        {
+            for (auto field : fields)
             {
 
                 if (field["class"].error() != simdjson::SUCCESS)
@@ -86,7 +167,12 @@ namespace parseShape
                 if (meshFuncs.find(className) != meshFuncs.end())
                 {
                     Mesh *mesh = meshFuncs[className](props);
+                    if (meshShader && meshShader != scene->GetShader())
+                        mesh->SetShader(meshShader);
+                    if (parent)
+                        mesh->SetParent(parent);
                     scene->AddMesh(mesh);
+                    std::vector<ParsedAnimation> animations;
                     for (auto modifier : field.get_object())
                     {
                         if (meshModifierFuncs.find(std::string(modifier.key)) != meshModifierFuncs.end())
@@ -103,7 +189,12 @@ namespace parseShape
                             std::string_view modfierClassName = modifier.key;
                             objectModifierFuncs[std::string(modfierClassName)](&(modifier.value), mesh);
                         }
+                        else if (modifier.key == "animate")
+                            Animate(&(modifier.value), mesh, animations);
                     }
+                    AddAnimations(scene, animations);
+                    if (field.at_key("children").error() == simdjson::SUCCESS)
+                        Children(field["children"].get_array(), scene, mesh, meshShader);
                 }
                 else if (objectFuncs.find(className) != objectFuncs.end())
                 {
@@ -111,6 +202,13 @@ namespace parseShape
                     Camera *camera = dynamic_cast<Camera *>(object);
                     if (camera != nullptr)
                         scene->SetCamera(camera);
+                    else
+                    {
+                        if (parent)
+                            object->SetParent(parent);
+                        scene->AddObject(object);
+                    }
+                    std::vector<ParsedAnimation> animations;
                     for (auto modifier : field.get_object())
                     {
                         if (objectModifierFuncs.find(std::string(modifier.key)) != objectModifierFuncs.end())
@@ -121,7 +219,12 @@ namespace parseShape
                                            { return std::tolower(c); });
                             objectModifierFuncs[modfierClass](&(modifier.value), object);
                         }
+                        else if (modifier.key == "animate")
+                            Animate(&(modifier.value), object, animations);
                     }
+                    AddAnimations(scene, animations);
+                    if (camera == nullptr && field.at_key("children").error() == simdjson::SUCCESS)
+                        Children(field["children"].get_array(), scene, object, meshShader);
                 }
                 else if (otherFuncs.find(className) != otherFuncs.end())
                 {
@@ -129,7 +232,9 @@ namespace parseShape
                     if (std::holds_alternative<Shader *>(ot))
                     {
                         Shader *shader = std::get<Shader *>(ot);
-                        scene->SetShader(shader);
+                        meshShader = shader;
+                        if (!scene->GetShader())
+                            scene->SetShader(shader);
                         for (auto modifier : field.get_object())
                         {
                             if (shaderModifierFuncs.find(std::string(modifier.key)) != shaderModifierFuncs.end())
@@ -141,7 +246,6 @@ namespace parseShape
                     }
                 }
             }
-            return scene;
         }
 
         Mesh *Box(simdjson::dom::element *element)
@@ -172,7 +276,7 @@ namespace parseShape
                 else if (element->at_key("height").error() == simdjson::SUCCESS)
                     height = element->at_key("height").get_double();
             }
-            return CreateBox(width, depth, height, 9);
+            return InstanceBox(width, depth, height, 9);
         }
         Mesh *Plane(simdjson::dom::element *element)
         {
@@ -192,7 +296,7 @@ namespace parseShape
                 else if (element->at_key("height").error() == simdjson::SUCCESS)
                     height = element->at_key("height").get_double();
             }
-            return CreatePlane(width, height, 9);
+            return InstancePlane(width, height, 9);
         }
         Mesh *Cylinder(simdjson::dom::element *element)
         {
@@ -220,7 +324,7 @@ namespace parseShape
                 else if (element->at_key("n").error() == simdjson::SUCCESS)
                     sectorCount = element->at_key("n").get_int64();
             }
-            return CreateCylinder(radius, height, sectorCount, 9);
+            return InstanceCylinder(radius, height, sectorCount, 9);
         }
         Mesh *Cone(simdjson::dom::element *element)
         {
@@ -248,7 +352,7 @@ namespace parseShape
                 else if (element->at_key("n").error() == simdjson::SUCCESS)
                     sectorCount = element->at_key("n").get_int64();
             }
-            return CreateCone(radius, height, sectorCount, 9);
+            return InstanceCone(radius, height, sectorCount, 9);
         }
 
         void Color(simdjson::dom::element *element, Mesh *mesh)
@@ -282,6 +386,17 @@ namespace parseShape
             if (mesh == nullptr)
                 return;
 
+            // En : A crease angle or the smooth key generates normals from the faces instead of setting one normal.
+            // Tr : Kırılma açısı ya da smooth anahtarı tek bir normal ayarlamak yerine yüzlerden normaller üretir.
+            if ((*element).at_key("crease").error() == simdjson::SUCCESS || (*element).at_key("smooth").error() == simdjson::SUCCESS)
+            {
+                float crease = 180.0f;
+                if ((*element).at_key("crease").error() == simdjson::SUCCESS)
+                    crease = (*element)["crease"].get_double();
+                GenerateNormals(mesh, crease);
+                return;
+            }
+
             float x = 0.0f, y = 0.0f, z = 0.0f;
             if ((*element).at_key("x").error() == simdjson::SUCCESS)
                 x = (*element)["x"].get_double();
@@ -297,6 +412,22 @@ namespace parseShape
                 mesh->ChangeVertex(glm::vec3(x, y, z), i, 3);
             }
         }
+        void LOD(simdjson::dom::element *element, Mesh *mesh)
+        {
+            if (mesh == nullptr)
+                return;
+
+            int levels = 3;
+            float ratio = 0.5f, screenSize = 0.25f;
+            if ((*element).at_key("levels").error() == simdjson::SUCCESS)
+                levels = (*element)["levels"].get_int64();
+            if ((*element).at_key("ratio").error() == simdjson::SUCCESS)
+                ratio = (*element)["ratio"].get_double();
+            if ((*element).at_key("screenSize").error() == simdjson::SUCCESS)
+                screenSize = (*element)["screenSize"].get_double();
+
+            BuildLODs(mesh, levels, ratio, screenSize);
+        }
 
         void Translate(simdjson::dom::element *element, Object *realObject)
         {
@@ -348,7 +479,51 @@ namespace parseShape
 
             realObject->Scale(glm::vec3(x, y, z));
         }
+        void Animate(simdjson::dom::element *element, Object *realObject, std::vector<ParsedAnimation> &animations)
+        {
+            if (realObject == nullptr)
+                return;
+            if (element->is_array())
+            {
+                for (simdjson::dom::element e : element->get_array())
+                    Animate(&e, realObject, animations);
+                return;
+            }
+
+            ParsedAnimation animation;
+            AnimationTrack &track = animation.track;
+            track.target = realObject;
+            if (element->at_key("property").error() != simdjson::SUCCESS ||
+                !AnimationPropertyOf(std::string((*element)["property"].get_string().value()), track.property))
+                return;
+            if (element->at_key("loop").error() == simdjson::SUCCESS)
+                track.loop = (*element)["loop"].get_bool();
+            if (element->at_key("keys").error() != simdjson::SUCCESS)
+                return;
+
+            const char *components[3] = {"x", "y", "z"};
+            for (simdjson::dom::element key : (*element)["keys"].get_array())
+            {
+                ParsedKey parsed;
+                if (key.at_key("t").error() == simdjson::SUCCESS)
+                    parsed.time = key["t"].get_double();
+                else if (key.at_key("time").error() == simdjson::SUCCESS)
+                    parsed.time = key["time"].get_double();
+                for (int i = 0; i < 3; i++)
+                    if (key.at_key(components[i]).error() == simdjson::SUCCESS)
+                    {
+                        parsed.value[i] = key[components[i]].get_double();
+                        parsed.given[i] = true;
+                    }
+                animation.keys.push_back(parsed);
+            }
+            animations.push_back(std::move(animation));
+        }
 
+        Object *Group(simdjson::dom::element *element)
+        {
+            return new Object();
+        }
         Camera *_Camera(simdjson::dom::element *element)
         {
             Camera *camera = new Camera();
@@ -391,6 +566,28 @@ namespace parseShape
             return camera;
         }
 
+        Light *_Light(simdjson::dom::element *element)
+        {
+            Light *light = new Light();
+            if (element == nullptr)
+                return light;
+            glm::vec3 color(1.0f);
+            const char *channels[3][2] = {{"r", "red"}, {"g", "green"}, {"b", "blue"}};
+            for (int i = 0; i < 3; i++)
+            {
+                if (element->at_key(channels[i][0]).error() == simdjson::SUCCESS)
+                    color[i] = element->at_key(channels[i][0]).get_double();
+                else if (element->at_key(channels[i][1]).error() == simdjson::SUCCESS)
+                    color[i] = element->at_key(channels[i][1]).get_double();
+            }
+            light->SetColor(color);
+            if (element->at_key("intensity").error() == simdjson::SUCCESS)
+                light->SetIntensity(element->at_key("intensity").get_double());
+            if (element->at_key("range").error() == simdjson::SUCCESS)
+                light->SetRange(element->at_key("range").get_double());
+            return light;
+        }
+
         Shader *_Shader(simdjson::dom::element *element)
         {
             Shader *shader = nullptr;
@@ -423,6 +620,27 @@ namespace parseShape
         {
             Scene *scene = new Scene();
 
+            if (const char *quantize = element->Attribute("quantize"))
+            {
+                if (std::strcmp(quantize, "half") == 0)
+                    scene->SetQuantized(true, VertexEncoding::Half);
+                else if (std::strcmp(quantize, "snorm16") == 0 || std::strcmp(quantize, "true") == 0)
+                    scene->SetQuantized(true, VertexEncoding::Snorm16);
+            }
+
+            Children(element, scene, nullptr);
+
+            globalShader = nullptr;
+
+            return scene;
+        }
+
+        // En : Parses the objects inside `element`, meshes and groups can be nested and are attached to `parent`.
+        // Cameras stay in world space.
+        // Tr : `element` içindeki nesneleri ayrıştırır, meshler ve gruplar iç içe olabilir ve `parent`'a bağlanır.
+        // Kameralar dünya uzayında kalır.
+        void Children(tinyxml2::XMLElement *element, Scene *scene, Object *parent)
+        {
             for (tinyxml2::XMLElement *e = element->FirstChildElement(); e != nullptr; e = e->NextSiblingElement())
             {
                 std::string typeName(e->Name());
@@ -431,7 +649,12 @@ namespace parseShape
                 if (meshFuncs.find(typeName) != meshFuncs.end())
                 {
                     Mesh *mesh = meshFuncs[typeName](e);
+                    if (globalShader && globalShader != scene->GetShader())
+                        mesh->SetShader(globalShader);
+                    if (parent)
+                        mesh->SetParent(parent);
                     scene->AddMesh(mesh);
+                    std::vector<ParsedAnimation> animations;
                     for (tinyxml2::XMLElement *o = e->FirstChildElement(); o != nullptr; o = o->NextSiblingElement())
                     {
                         std::string objectName(o->Name());
@@ -443,7 +666,12 @@ namespace parseShape
 
                         if (objectModifierFuncs.find(objectName) != objectModifierFuncs.end())
                             objectModifierFuncs[objectName](o, mesh);
+
+                        if (objectName == "animate")
+                            Animate(o, mesh, animations);
                     }
+                    AddAnimations(scene, animations);
+                    Children(e, scene, mesh);
                 }
                 if (objectFuncs.find(typeName) != objectFuncs.end())
                 {
@@ -451,6 +679,13 @@ namespace parseShape
                     Camera *camera = dynamic_cast<Camera *>(object);
                     if (camera != nullptr)
                         scene->SetCamera(camera);
+                    else
+                    {
+                        if (parent)
+                            object->SetParent(parent);
+                        scene->AddObject(object);
+                    }
+                    std::vector<ParsedAnimation> animations;
                     for (tinyxml2::XMLElement *o = e->FirstChildElement(); o; o = o->NextSiblingElement())
                     {
                         std::string objectName(o->Name());
@@ -459,7 +694,12 @@ namespace parseShape
 
                         if (objectModifierFuncs.find(objectName) != objectModifierFuncs.end())
                             objectModifierFuncs[objectName](o, object);
+                        else if (objectName == "animate")
+                            Animate(o, object, animations);
                     }
+                    AddAnimations(scene, animations);
+                    if (camera == nullptr)
+                        Children(e, scene, object);
                 }
                 if (otherFuncs.find(typeName) != otherFuncs.end())
                 {
@@ -467,9 +707,11 @@ namespace parseShape
                     if (std::holds_alternative<Shader *>(ot))
                     {
                         Shader *shader = std::get<Shader *>(ot);
-                        if (!globalShader)
-                            globalShader = shader;
-                        scene->SetShader(shader);
+                        // En : The first shader is the scene shader, meshes after a later one are drawn with it.
+                        // Tr : İlk shader sahne shader'ıdır, sonraki bir shader'dan sonra gelen meshler onunla çizilir.
+                        globalShader = shader;
+                        if (!scene->GetShader())
+                            scene->SetShader(shader);
                         for (tinyxml2::XMLElement *o = e->FirstChildElement(); o; o = o->NextSiblingElement())
                         {
                             std::string objectName(o->Name());
@@ -482,10 +724,6 @@ namespace parseShape
                     }
                 }
             }
-
-            globalShader = nullptr;
-
-            return scene;
         }
 
         Mesh *Box(tinyxml2::XMLElement *element)
@@ -513,9 +751,9 @@ namespace parseShape
                 height = element->FloatAttribute("height");
 
             if (globalShader)
-                return CreateBox(width, depth, height, globalShader);
+                return InstanceBox(width, depth, height, globalShader);
             else
-                return CreateBox(width, depth, height, 9);
+                return InstanceBox(width, depth, height, 9);
         }
         Mesh *Plane(tinyxml2::XMLElement *element)
         {
@@ -530,9 +768,9 @@ namespace parseShape
                 height = element->FloatAttribute("height");
 
             if (globalShader)
-                return CreatePlane(width, height, globalShader);
+                return InstancePlane(width, height, globalShader);
             else
-                return CreatePlane(width, height, 9);
+                return InstancePlane(width, height, 9);
         }
         Mesh *Cylinder(tinyxml2::XMLElement *element)
         {
@@ -559,9 +797,9 @@ namespace parseShape
                 sectorCount = element->IntAttribute("n");
 
             if (globalShader)
-                return CreateCylinder(radius, height, sectorCount, globalShader);
+                return InstanceCylinder(radius, height, sectorCount, globalShader);
             else
-                return CreateCylinder(radius, height, sectorCount, 9);
+                return InstanceCylinder(radius, height, sectorCount, 9);
         }
         Mesh *Cone(tinyxml2::XMLElement *element)
         {
@@ -581,9 +819,9 @@ namespace parseShape
                 sectorCount = element->IntAttribute("resolution");
 
             if (globalShader)
-                return CreateCone(radius, height, sectorCount, globalShader);
+                return InstanceCone(radius, height, sectorCount, globalShader);
             else
-                return CreateCone(radius, height, sectorCount, 9);
+                return InstanceCone(radius, height, sectorCount, 9);
         }
 
         void Color(tinyxml2::XMLElement *element, Mesh *mesh)
@@ -617,6 +855,14 @@ namespace parseShape
             if (mesh == nullptr)
                 return;
 
+            // En : A crease angle or the smooth attribute generates normals from the faces instead of setting one normal.
+            // Tr : Kırılma açısı ya da smooth attribute'u tek bir normal ayarlamak yerine yüzlerden normaller üretir.
+            if (element->Attribute("crease") || element->Attribute("smooth"))
+            {
+                GenerateNormals(mesh, element->FloatAttribute("crease", 180.0f));
+                return;
+            }
+
             float x = 0.0f, y = 0.0f, z = 0.0f;
             if (element->Attribute("x"))
                 x = element->FloatAttribute("x");
@@ -674,6 +920,22 @@ namespace parseShape
             for (int i = 0; i < mesh->GetVertexCount(); i++)
                 func(i);
         }
+        void LOD(tinyxml2::XMLElement *element, Mesh *mesh)
+        {
+            if (mesh == nullptr)
+                return;
+
+            int levels = 3;
+            float ratio = 0.5f, screenSize = 0.25f;
+            if (element->Attribute("levels"))
+                levels = element->IntAttribute("levels");
+            if (element->Attribute("ratio"))
+                ratio = element->FloatAttribute("ratio");
+            if (element->Attribute("screenSize"))
+                screenSize = element->FloatAttribute("screenSize");
+
+            BuildLODs(mesh, levels, ratio, screenSize);
+        }
 
         void Translate(tinyxml2::XMLElement *element, Object *object)
         {
@@ -727,7 +989,39 @@ namespace parseShape
 
             object->Scale(glm::vec3(x, y, z));
         }
+        void Animate(tinyxml2::XMLElement *element, Object *object, std::vector<ParsedAnimation> &animations)
+        {
+            if (object == nullptr)
+                return;
 
+            ParsedAnimation animation;
+            AnimationTrack &track = animation.track;
+            track.target = object;
+            const char *property = element->Attribute("property");
+            if (!property || !AnimationPropertyOf(property, track.property))
+                return;
+            track.loop = element->BoolAttribute("loop", true);
+
+            const char *components[3] = {"x", "y", "z"};
+            for (tinyxml2::XMLElement *key = element->FirstChildElement(); key; key = key->NextSiblingElement())
+            {
+                ParsedKey parsed;
+                parsed.time = key->Attribute("t") ? key->FloatAttribute("t") : key->FloatAttribute("time");
+                for (int i = 0; i < 3; i++)
+                    if (key->Attribute(components[i]))
+                    {
+                        parsed.value[i] = key->FloatAttribute(components[i]);
+                        parsed.given[i] = true;
+                    }
+                animation.keys.push_back(parsed);
+            }
+            animations.push_back(std::move(animation));
+        }
+
+        Object *Group(tinyxml2::XMLElement *element)
+        {
+            return new Object();
+        }
         Camera *_Camera(tinyxml2::XMLElement *element)
         {
             Camera *camera = new Camera();
@@ -769,6 +1063,26 @@ namespace parseShape
             return camera;
         }
 
+        Light *_Light(tinyxml2::XMLElement *element)
+        {
+            Light *light = new Light();
+            glm::vec3 color(1.0f);
+            const char *channels[3][2] = {{"r", "red"}, {"g", "green"}, {"b", "blue"}};
+            for (int i = 0; i < 3; i++)
+            {
+                if (element->Attribute(channels[i][0]))
+                    color[i] = element->FloatAttribute(channels[i][0]);
+                else if (element->Attribute(channels[i][1]))
+                    color[i] = element->FloatAttribute(channels[i][1]);
+            }
+            light->SetColor(color);
+            if (element->Attribute("intensity"))
+                light->SetIntensity(element->FloatAttribute("intensity"));
+            if (element->Attribute("range"))
+                light->SetRange(element->FloatAttribute("range"));
+            return light;
+        }
+
         Shader *_Shader(tinyxml2::XMLElement *element)
         {
             Shader *shader = nullptr;
@@ -5,8 +5,12 @@
 #include "Object.h"
 #include "Mesh.h"
 #include "Camera.h"
+#include "Light.h"
 #include "Shader.h"
 #include "Vertex.h"
+#include "MeshSimplify.h"
+#include "MeshNormals.h"
+#include "Primitive.h"
 
 #include <tinyxml2.h>
 #include <simdjson.h>
@@ -19,10 +23,29 @@ namespace parseShape
 {
     Scene *Parse(std::string path);
     typedef std::variant<Shader *, Scene *, Vertex> OtherType;
+
+    // En : A key of an animate modifier, `given` tells which of x, y and z were written.
+    // Tr : Bir animate değiştiricisinin anahtarı, `given` x, y ve z'den hangilerinin yazıldığını söyler.
+    struct ParsedKey
+    {
+        float time = 0.0f;
+        glm::vec3 value = glm::vec3(0.0f);
+        bool given[3] = {false, false, false};
+    };
+    // En : A track read from an animate modifier. The tracks of an element are resolved after all of its modifiers were applied,
+    // so the missing key components and the scale factor come from its final transform.
+    // Tr : Bir animate değiştiricisinden okunan bir iz. Bir elemanın izleri tüm değiştiricileri uygulandıktan sonra çözülür,
+    // böylece eksik anahtar bileşenleri ve ölçek çarpanı son dönüşümünden gelir.
+    struct ParsedAnimation
+    {
+        AnimationTrack track;
+        std::vector<ParsedKey> keys;
+    };
     namespace xml
     {
         Scene *Parse(tinyxml2::XMLDocument *document);
         Scene *Parse(tinyxml2::XMLElement *element);
+        void Children(tinyxml2::XMLElement *element, Scene *scene, Object *parent);
 
         Mesh *Box(tinyxml2::XMLElement *element);
         Mesh *Plane(tinyxml2::XMLElement *element);
@@ -32,12 +55,22 @@ namespace parseShape
         void Color(tinyxml2::XMLElement *element, Mesh *mesh);
         void Normal(tinyxml2::XMLElement *element, Mesh *mesh);
         void Set_Mesh(tinyxml2::XMLElement *element, Mesh *mesh);
+        void LOD(tinyxml2::XMLElement *element, Mesh *mesh);
 
         void Translate(tinyxml2::XMLElement *element, Object *object);
         void Rotate(tinyxml2::XMLElement *element, Object *object);
         void Scale(tinyxml2::XMLElement *element, Object *object);
+        // En : Reads the keyframe track of an <Animate> element into `animations`, keys are its <Key> children.
+        // Tr : Bir <Animate> elemanının anahtar kare izini `animations`'a okur, anahtarlar <Key> çocuklarıdır.
+        void Animate(tinyxml2::XMLElement *element, Object *object, std::vector<ParsedAnimation> &animations);
 
+        // En : An empty object that only carries a transform for the objects nested in it.
+        // Tr : Yalnızca içine yerleştirilen nesneler için bir dönüşüm taşıyan boş bir nesne.
+        Object *Group(tinyxml2::XMLElement *element);
         Camera *_Camera(tinyxml2::XMLElement *element);
+        // En : A point light, the color is given with `r`, `g` and `b`, it reaches as far as `range`.
+        // Tr : Bir nokta ışık, renk `r`, `g` ve `b` ile verilir, `range` kadar uzağa ulaşır.
+        Light *_Light(tinyxml2::XMLElement *element);
 
         Shader *_Shader(tinyxml2::XMLElement *element);
 
@@ -47,10 +80,10 @@ namespace parseShape
             {{"box", Box}, {"plane", Plane}, {"cylinder", Cylinder}, {"cone", Cone}};
 
         inline std::map<std::string, std::function<void(tinyxml2::XMLElement *, Mesh *)>> meshModifierFuncs =
-            {{"color", Color}, {"normal", Normal}, {"set", Set_Mesh}};
+            {{"color", Color}, {"normal", Normal}, {"set", Set_Mesh}, {"lod", LOD}};
 
         inline std::map<std::string, std::function<Object *(tinyxml2::XMLElement *)>> objectFuncs =
-            {{"camera", _Camera}, {"cam", _Camera}};
+            {{"camera", _Camera}, {"cam", _Camera}, {"group", Group}, {"light", _Light}};
 
         inline std::map<std::string, std::function<void(tinyxml2::XMLElement *, Object *)>> objectModifierFuncs =
             {{"translate", Translate}, {"rotate", Rotate}, {"scale", Scale}};
@@ -66,6 +99,7 @@ namespace parseShape
 
         Scene *Parse(simdjson::dom::document *document);
         Scene *Parse(simdjson::dom::element *element);
+        void Children(simdjson::dom::array fields, Scene *scene, Object *parent, Shader *&meshShader);
 
         Mesh *Box(simdjson::dom::element *element);
         Mesh *Plane(simdjson::dom::element *element);
@@ -74,12 +108,20 @@ namespace parseShape
 
         void Color(simdjson::dom::element *element, Mesh *mesh);
         void Normal(simdjson::dom::element *element, Mesh *mesh);
+        void LOD(simdjson::dom::element *element, Mesh *mesh);
 
         void Translate(simdjson::dom::element *element, Object *realObject);
         void Rotate(simdjson::dom::element *element, Object *realObject);
         void Scale(simdjson::dom::element *element, Object *realObject);
+        // En : Reads the keyframe tracks of an "animate" object or array into `animations`, keys are listed under "keys".
+        // Tr : Bir "animate" nesnesinin ya da dizisinin anahtar kare izlerini `animations`'a okur, anahtarlar "keys" altında listelenir.
+        void Animate(simdjson::dom::element *element, Object *realObject, std::vector<ParsedAnimation> &animations);
 
+        Object *Group(simdjson::dom::element *element);
         Camera *_Camera(simdjson::dom::element *element);
+        // En : A point light, the color is given with "r", "g" and "b", it reaches as far as "range".
+        // Tr : Bir nokta ışık, renk "r", "g" ve "b" ile verilir, "range" kadar uzağa ulaşır.
+        Light *_Light(simdjson::dom::element *element);
 
         Shader *_Shader(simdjson::dom::element *element);
 
@@ -89,10 +131,10 @@ namespace parseShape
             {{"box", Box}, {"plane", Plane}, {"cylinder", Cylinder}, {"cone", Cone}};
 
         inline std::map<std::string, std::function<void(simdjson::dom::element *, Mesh *)>> meshModifierFuncs =
-            {{"color", Color}, {"normal", Normal}};
+            {{"color", Color}, {"normal", Normal}, {"lod", LOD}};
 
         inline std::map<std::string, std::function<Object *(simdjson::dom::element *)>> objectFuncs =
-            {{"camera", _Camera}, {"cam", _Camera}};
+            {{"camera", _Camera}, {"cam", _Camera}, {"group", Group}, {"light", _Light}};
 
         inline std::map<std::string, std::function<void(simdjson::dom::element *, Object *)>> objectModifierFuncs =
             {{"translate", Translate}, {"rotate", Rotate}, {"scale", Scale}};
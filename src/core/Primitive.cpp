@@ -0,0 +1,137 @@
+#ifndef PRIMITIVE_CPP
+#define PRIMITIVE_CPP
+
+#include "Primitive.h"
+
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+namespace parseShape
+{
+    bool PrimitiveKey::operator<(const PrimitiveKey &other) const
+    {
+        return std::tie(type, resolution, count, vertexSize, ratios[0], ratios[1]) <
+               std::tie(other.type, other.resolution, other.count, other.vertexSize, other.ratios[0], other.ratios[1]);
+    }
+
+    PrimitiveCache::~PrimitiveCache()
+    {
+        Clear();
+    }
+    Mesh *PrimitiveCache::Instance(const PrimitiveKey &key, const std::function<Mesh *()> &create)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = primitives.find(key);
+        if (it == primitives.end())
+        {
+            Mesh *unit = create();
+            if (!unit)
+                return nullptr;
+            it = primitives.insert({key, unit}).first;
+        }
+        return new Mesh(*it->second);
+    }
+    void PrimitiveCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto &it : primitives)
+            delete it.second;
+        primitives.clear();
+    }
+    size_t PrimitiveCache::GetCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return primitives.size();
+    }
+
+    PrimitiveCache &GetPrimitiveCache()
+    {
+        static PrimitiveCache cache;
+        return cache;
+    }
+
+    const std::vector<glm::vec2> &GetSinCosTable(int count, float step)
+    {
+        static std::map<std::pair<int, float>, std::vector<glm::vec2>> tables;
+        static std::mutex mutex;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<glm::vec2> &table = tables[{count, step}];
+        if (table.empty() && count > 0)
+        {
+            table.resize(count);
+            for (int i = 0; i < count; i++)
+            {
+                float angle = i * step;
+                table[i] = glm::vec2(std::cos(angle), std::sin(angle));
+            }
+        }
+        return table;
+    }
+
+    static Mesh *Instance(const PrimitiveKey &key, glm::vec3 size, const std::function<Mesh *()> &create)
+    {
+        Mesh *mesh = GetPrimitiveCache().Instance(key, create);
+        if (mesh)
+            mesh->SetScale(size);
+        return mesh;
+    }
+    static Mesh *Adapt(Mesh *mesh, Shader *shader)
+    {
+        if (mesh)
+            mesh->Adapt(shader);
+        return mesh;
+    }
+
+    Mesh *InstanceBox(float width, float height, float depth, int vertexSize)
+    {
+        PrimitiveKey key;
+        key.type = PrimitiveType::Box;
+        key.vertexSize = vertexSize;
+        return Instance(key, glm::vec3(width, height, depth), [vertexSize]()
+                        { return CreateBox(1.0f, 1.0f, 1.0f, vertexSize); });
+    }
+    Mesh *InstanceBox(float width, float height, float depth, Shader *shader)
+    {
+        return Adapt(InstanceBox(width, height, depth, shader->GetAttributeSize()), shader);
+    }
+    Mesh *InstancePlane(float width, float height, int vertexSize)
+    {
+        PrimitiveKey key;
+        key.type = PrimitiveType::Plane;
+        key.vertexSize = vertexSize;
+        return Instance(key, glm::vec3(width, 1.0f, height), [vertexSize]()
+                        { return CreatePlane(1.0f, 1.0f, vertexSize); });
+    }
+    Mesh *InstancePlane(float width, float height, Shader *shader)
+    {
+        return Adapt(InstancePlane(width, height, shader->GetAttributeSize()), shader);
+    }
+    Mesh *InstanceCylinder(float radius, float height, int sectorCount, int vertexSize)
+    {
+        PrimitiveKey key;
+        key.type = PrimitiveType::Cylinder;
+        key.resolution = sectorCount;
+        key.vertexSize = vertexSize;
+        return Instance(key, glm::vec3(radius, height, radius), [sectorCount, vertexSize]()
+                        { return CreateCylinder(1.0f, 1.0f, sectorCount, vertexSize); });
+    }
+    Mesh *InstanceCylinder(float radius, float height, int sectorCount, Shader *shader)
+    {
+        return Adapt(InstanceCylinder(radius, height, sectorCount, shader->GetAttributeSize()), shader);
+    }
+    Mesh *InstanceCone(float radius, float height, int sectorCount, int vertexSize)
+    {
+        PrimitiveKey key;
+        key.type = PrimitiveType::Cone;
+        key.resolution = sectorCount;
+        key.vertexSize = vertexSize;
+        return Instance(key, glm::vec3(radius, height, radius), [sectorCount, vertexSize]()
+                        { return CreateCone(1.0f, 1.0f, sectorCount, vertexSize); });
+    }
+    Mesh *InstanceCone(float radius, float height, int sectorCount, Shader *shader)
+    {
+        return Adapt(InstanceCone(radius, height, sectorCount, shader->GetAttributeSize()), shader);
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef PRIMITIVE_H
+#define PRIMITIVE_H
+
+#include "Mesh.h"
+#include "Shader.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <glm/glm.hpp>
+
+namespace parseShape
+{
+    enum class PrimitiveType
+    {
+        Box,
+        Plane,
+        Cylinder,
+        Cone,
+        Gear
+    };
+
+    // En : Identifies a unit primitive, the size is not a part of the key since it is applied through the object transform.
+    // `ratios` hold shape proportions that can not be expressed with a scale, like the radii of a gear.
+    // Tr : Bir birim primitifi tanımlar, boyut anahtarın parçası değildir çünkü nesne dönüşümü ile uygulanır.
+    // `ratios` bir ölçek ile ifade edilemeyen şekil oranlarını tutar, bir dişlinin yarıçapları gibi.
+    struct PrimitiveKey
+    {
+        PrimitiveType type = PrimitiveType::Box;
+        int resolution = 0, count = 0, vertexSize = 0;
+        float ratios[2] = {0.0f, 0.0f};
+
+        bool operator<(const PrimitiveKey &other) const;
+    };
+
+    // En : Keeps one unit mesh for every primitive key, instances copy it instead of generating it again.
+    // Tr : Her primitif anahtarı için bir birim mesh tutar, örnekler onu yeniden üretmek yerine kopyalar.
+    class PrimitiveCache
+    {
+    private:
+        std::map<PrimitiveKey, Mesh *> primitives;
+        mutable std::mutex mutex;
+
+    public:
+        PrimitiveCache() = default;
+        ~PrimitiveCache();
+
+        // En : Returns a copy of the unit mesh of the key, `create` is only called if the key is not cached.
+        // Tr : Anahtarın birim meshinin bir kopyasını döndürür, `create` yalnızca anahtar önbellekte yoksa çağrılır.
+        Mesh *Instance(const PrimitiveKey &key, const std::function<Mesh *()> &create);
+        void Clear();
+        size_t GetCount() const;
+    };
+
+    // En : Returns the cache used by the Instance functions.
+    // Tr : Instance fonksiyonlarının kullandığı önbelleği döndürür.
+    PrimitiveCache &GetPrimitiveCache();
+    // En : Returns cos and sin of `i * step` as x and y for i in [0, count), tables are shared between calls.
+    // Tr : [0, count) aralığındaki i için `i * step` açısının cos ve sin değerlerini x ve y olarak döndürür, tablolar çağrılar arasında paylaşılır.
+    const std::vector<glm::vec2> &GetSinCosTable(int count, float step);
+
+    // En : Creates primitives from the cache, the size is set as the scale of the mesh.
+    // Tr : Önbellekten primitifler oluşturur, boyut meshin ölçeği olarak ayarlanır.
+    Mesh *InstanceBox(float width, float height, float depth, int vertexSize = 3);
+    Mesh *InstanceBox(float width, float height, float depth, Shader *shader);
+    Mesh *InstancePlane(float width, float height, int vertexSize = 3);
+    Mesh *InstancePlane(float width, float height, Shader *shader);
+    Mesh *InstanceCylinder(float radius, float height, int sectorCount, int vertexSize = 3);
+    Mesh *InstanceCylinder(float radius, float height, int sectorCount, Shader *shader);
+    Mesh *InstanceCone(float radius, float height, int sectorCount, int vertexSize = 3);
+    Mesh *InstanceCone(float radius, float height, int sectorCount, Shader *shader);
+}
+#endif
\ No newline at end of file
@@ -2,28 +2,95 @@
 #define SCENE_CPP
 
 #include "Scene.h"
+#include "Parallel.h"
 #include <iostream>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <numeric>
+#include <unordered_set>
 
 namespace parseShape
 {
-    Scene::Scene()
+    Scene::Scene(BufferPool *bufferPool) : bufferPool(bufferPool ? bufferPool : BufferPool::GetShared())
     {
-        glGenVertexArrays(1, &vao);
-        glGenBuffers(1, &vbo);
-        glGenBuffers(1, &ebo);
+        glGenBuffers(1, &objectIndices);
+        glGenBuffers(1, &transformBuffer);
+        glGenTextures(1, &transformTexture);
+        indirectSupported = GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+        if (indirectSupported)
+            glGenBuffers(1, &indirectBuffer);
     }
     Scene::~Scene()
     {
-        glDeleteVertexArrays(1, &vao);
-        glDeleteBuffers(1, &vbo);
-        glDeleteBuffers(1, &ebo);
-        delete[] _vertices;
-        delete[] _indices;
+        DeleteBatches();
+        bufferPool->Free(vertexBlock);
+        bufferPool->Free(indexBlock);
+        glDeleteBuffers(1, &objectIndices);
+        glDeleteBuffers(1, &transformBuffer);
+        glDeleteTextures(1, &transformTexture);
+        if (indirectBuffer)
+            glDeleteBuffers(1, &indirectBuffer);
+    }
+
+    // En : Static draws of more updates in a row than this are moved to the stream buffer, they go back to the static
+    // buffer after `staticThreshold` updates in a row without a change. The flag of the mesh is left to its owner.
+    // Tr : Art arda bundan fazla güncellemede değişen statik çizimler akış buffer'ına taşınır, art arda `staticThreshold`
+    // güncelleme değişmeden kalırlarsa statik buffer'a geri dönerler. Meshin bayrağı sahibine bırakılır.
+    static const unsigned int dynamicThreshold = 3, staticThreshold = 60;
+    // En : Number of draws a thread takes at once when meshes are written in parallel.
+    // Tr : Meshler paralel yazılırken bir thread'in tek seferde aldığı çizim sayısı.
+    static const size_t drawBatch = 8;
+    // En : Pending uploads separated by fewer bytes than this are merged into one call, the gap is uploaded again unchanged.
+    // Tr : Aralarında bundan az bayt olan bekleyen yüklemeler tek çağrıda birleştirilir, aradaki boşluk değişmeden yeniden yüklenir.
+    static const size_t uploadGap = 4096;
+    // En : Shaders that declare both of these get the world matrix of every draw, the texture buffer is bound to `objectTransformUnit`.
+    // `useObjectTransformsName` tells the shader whether the buffer is bound, without it the shader keeps the baked vertices.
+    // Tr : İkisini de tanımlayan shader'lar her çizimin dünya matrisini alır, doku buffer'ı `objectTransformUnit`'e bağlanır.
+    // `useObjectTransformsName` shader'a buffer'ın bağlı olup olmadığını söyler, o olmadan shader hazır vertex'leri korur.
+    static const char *objectIndexName = "aObject", *objectTransformsName = "objectTransforms", *useObjectTransformsName = "useObjectTransforms";
+    static const int objectTransformUnit = 15;
+    // En : The light grid takes this unit and the two before the object transforms.
+    // Tr : Işık ızgarası bu birimi ve nesne dönüşümlerinden önceki iki birimi alır.
+    static const int lightUnit = 12;
+    // En : Visible meshes covering at least this ratio of the screen height are occluders, the largest ones are taken
+    // until their triangles reach the budget.
+    // Tr : Ekran yüksekliğinin en az bu oranını kaplayan görünür meshler örtendir, en büyükleri üçgenleri
+    // bütçeye ulaşana kadar alınır.
+    static const float occluderSize = 0.1f;
+    static const size_t occluderBudget = 32768;
+
+    // En : Writes the vertices [begin, end) of the draw's mesh, in mesh space for local draws and in world space otherwise.
+    // Tr : Çizimin meshinin [begin, end) vertex'lerini yazar, yerel çizimler için mesh uzayında, aksi halde dünya uzayında.
+    static void WriteMeshVertices(const MeshDraw &draw, int normalOffset, float *destination, unsigned int begin, unsigned int end)
+    {
+        if (!draw.local)
+        {
+            draw.mesh->WriteVertices(destination, begin, end, normalOffset);
+            return;
+        }
+        const size_t stride = draw.mesh->GetVertexSize();
+        const float *source = draw.mesh->GetVertexData().data();
+        end = std::min(end, (unsigned int)draw.mesh->GetVertexCount());
+        if (begin < end)
+            std::copy(source + begin * stride, source + end * stride, destination);
+    }
+
+    void GeometrySlab::Resize(size_t vertexSize)
+    {
+        if (vertexSize > vertexCapacity)
+        {
+            vertices.reset(new float[vertexSize]);
+            vertexCapacity = vertexSize;
+        }
+        this->vertexSize = vertexSize;
     }
 
     void Scene::SetShader(Shader *shader)
     {
         this->shader = shader;
+        layoutDirty = true;
     }
     Shader *Scene::GetShader() const
     {
@@ -47,11 +114,17 @@ namespace parseShape
     void Scene::AddObject(Object *object)
     {
         objects.push_back(object);
+        if (transformStore)
+            object->AttachTo(transformStore);
         Mesh *mesh = dynamic_cast<Mesh *>(object);
         if (mesh)
         {
             meshes.push_back(mesh);
+            layoutDirty = true;
         }
+        Light *light = dynamic_cast<Light *>(object);
+        if (light)
+            lights.push_back(light);
     }
     std::vector<Object *> Scene::GetObjects() const
     {
@@ -60,64 +133,879 @@ namespace parseShape
     void Scene::AddMesh(Mesh *mesh)
     {
         meshes.push_back(mesh);
+        if (transformStore)
+            mesh->AttachTo(transformStore);
+        layoutDirty = true;
     }
     std::vector<Mesh *> Scene::GetMeshes() const
     {
         return meshes;
     }
+    void Scene::SetTransformStore(TransformStore *store)
+    {
+        transformStore = store;
+        for (auto object : objects)
+            object->AttachTo(store);
+        for (auto mesh : meshes)
+            mesh->AttachTo(store);
+    }
+    TransformStore *Scene::GetTransformStore() const
+    {
+        return transformStore;
+    }
+    Animator &Scene::GetAnimator()
+    {
+        return animator;
+    }
+    const std::vector<Light *> &Scene::GetLights() const
+    {
+        return lights;
+    }
+    const LightGrid &Scene::GetLightGrid() const
+    {
+        return lightGrid;
+    }
 
-    void Scene::Update()
+    void Scene::SetQuantized(bool quantized, VertexEncoding positionEncoding)
+    {
+        this->quantized = quantized;
+        this->positionEncoding = positionEncoding;
+        layoutDirty = true;
+    }
+    const VertexFormat *Scene::GetVertexFormat() const
+    {
+        for (auto &batch : batches)
+            if (batch.packed && batch.shader == shader)
+                return &batch.format;
+        return nullptr;
+    }
+
+    static size_t RoundUp(size_t value, size_t multiple)
+    {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    // En : Returns true if the ranges of the meshes no longer fit their data.
+    // Tr : Meshlerin aralıkları artık verilerine uymuyorsa true döndürür.
+    bool Scene::NeedsLayout() const
+    {
+        if (layoutDirty)
+            return true;
+        for (auto &draw : draws)
+        {
+            Mesh *mesh = draw.mesh;
+            unsigned int count = mesh->GetIndexData().size();
+            for (int level = 0; level < mesh->GetLODCount(); level++)
+                count += mesh->GetLOD(level).indices.size();
+            if ((unsigned int)mesh->GetVertexCount() != draw.vertexCount || count != draw.indexCount)
+                return true;
+            const RenderBatch &batch = batches[draw.batch];
+            if (batch.dynamic != (mesh->IsDynamic() || draw.promoted) || batch.shader != (mesh->GetShader() ? mesh->GetShader() : shader))
+                return true;
+        }
+        return false;
+    }
+    void Scene::DeleteBatches()
+    {
+        for (auto &batch : batches)
+            glDeleteVertexArrays(1, &batch.vao);
+        batches.clear();
+    }
+    void Scene::SetFrustumCulling(bool frustumCulling)
+    {
+        this->frustumCulling = frustumCulling;
+    }
+    bool Scene::GetFrustumCulling() const
+    {
+        return frustumCulling;
+    }
+    void Scene::SetIndirectDraw(bool indirectDraw)
+    {
+        this->indirectDraw = indirectDraw;
+    }
+    bool Scene::GetIndirectDraw() const
     {
-        vertices.clear();
-        indices.clear();
+        return indirectDraw && indirectSupported;
+    }
+    void Scene::SetOcclusionCulling(bool occlusionCulling)
+    {
+        this->occlusionCulling = occlusionCulling;
+    }
+    bool Scene::GetOcclusionCulling() const
+    {
+        return occlusionCulling;
+    }
+    const OcclusionBuffer &Scene::GetOcclusionBuffer() const
+    {
+        return occlusion;
+    }
+    CullStats Scene::GetCullStats() const
+    {
+        return cullStats;
+    }
+    BufferPool *Scene::GetBufferPool() const
+    {
+        return bufferPool;
+    }
+    size_t Scene::GetGPUMemory() const
+    {
+        size_t bytes = bufferPool->GetSize(vertexBlock) + bufferPool->GetSize(indexBlock);
+        bytes += stream.GetSegmentSize() * stream.GetSegmentCount();
+        if (objectTransforms)
+            bytes += objectIndexBytes + transforms.size() * sizeof(glm::mat4);
+        return bytes;
+    }
+
+    const BVH &Scene::GetBVH()
+    {
+        if (!bvhBuilt || (bvhDirty && !bvh.Refit()))
+            bvh.Build(meshes);
+        bvhBuilt = true;
+        bvhDirty = false;
+        return bvh;
+    }
+    BVHHit Scene::Pick(const Ray &ray)
+    {
+        return GetBVH().Intersect(ray);
+    }
+
+    // En : Returns the batch of the shader and the buffer, a new one is added if there is none.
+    // Tr : Shader'ın ve buffer'ın batch'ini döndürür, yoksa yenisi eklenir.
+    int Scene::FindBatch(Shader *shader, bool dynamic)
+    {
+        int program = batches.size();
+        for (int i = 0; i < (int)batches.size(); i++)
+        {
+            if (batches[i].shader != shader)
+                continue;
+            program = std::min(program, batches[i].program);
+            if (batches[i].dynamic == dynamic)
+                return i;
+        }
+        RenderBatch batch;
+        batch.shader = shader;
+        batch.dynamic = dynamic;
+        batch.program = program;
+        batch.packed = quantized && shader && !dynamic;
+        if (batch.packed)
+            batch.format = CreateVertexFormat(shader, positionEncoding);
+        if (shader)
+        {
+            AttributeTypeName types = shader->GetAttributeTypes();
+            for (auto &it : shader->GetAttributeOffsets())
+            {
+                std::string name = it.first;
+                std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c)
+                               { return std::tolower(c); });
+                if (name.find("normal") != std::string::npos && types[it.first] == VEC3)
+                    batch.normalOffset = it.second;
+            }
+        }
+        if (shader && shader->GetUniforms().count(objectTransformsName))
+        {
+            batch.objectLocation = shader->GetAttributeLocation(objectIndexName);
+            batch.objectTransforms = batch.objectLocation >= 0;
+        }
+        batches.push_back(batch);
+        return batches.size() - 1;
+    }
+    // En : Gives every mesh its vertex range and index block, then writes and uploads everything.
+    // Meshes are grouped by batch, every range starts at a multiple of the mesh's stride so it can be drawn with a base vertex.
+    // Tr : Her meshe vertex aralığını ve index bloğunu verir, sonra her şeyi yazar ve yükler.
+    // Meshler batch'e göre gruplanır, her aralık base vertex ile çizilebilsin diye meshin adımının katında başlar.
+    void Scene::Layout()
+    {
+        std::unordered_set<Mesh *> promoted;
+        for (auto &draw : draws)
+            if (draw.promoted)
+                promoted.insert(draw.mesh);
+        DeleteBatches();
+        draws.clear();
+        hasLODs = false;
+        unsigned int indexOffset = 0;
         for (auto mesh : meshes)
         {
-            int size;
-            float *v = mesh->GetVertices(size);
-            vertices.insert(vertices.end(), v, v + size);
-            unsigned int *i = mesh->GetIndices(size);
-            unsigned int offset = indices.size() ? *std::max_element(indices.begin(), indices.end()) + 1 : 0;
-            for (int j = 0; j < size; j++)
+            int stride = mesh->GetVertexSize();
+            if (stride <= 0)
+                continue;
+            MeshDraw draw;
+            draw.mesh = mesh;
+            draw.promoted = !mesh->IsDynamic() && promoted.count(mesh);
+            draw.dynamic = mesh->IsDynamic() || draw.promoted;
+            draw.batch = FindBatch(mesh->GetShader() ? mesh->GetShader() : shader, draw.dynamic);
+            draw.local = batches[draw.batch].objectTransforms;
+            draw.vertexCount = mesh->GetVertexCount();
+            draw.indexOffset = indexOffset;
+            draw.indexCount = mesh->GetIndexData().size();
+            for (int level = 0; level < mesh->GetLODCount(); level++)
+                draw.indexCount += mesh->GetLOD(level).indices.size();
+            indexOffset += draw.indexCount;
+            hasLODs |= mesh->GetLODCount() > 0;
+            draws.push_back(draw);
+        }
+        indexCount = indexOffset;
+        std::stable_sort(draws.begin(), draws.end(), [](const MeshDraw &a, const MeshDraw &b)
+                         { return a.batch < b.batch; });
+        drawBounds.Resize(draws.size());
+
+        size_t slabFloats = 0, staticBytes = 0, streamBytes = 0, streamAlignment = 1;
+        for (auto &draw : draws)
+        {
+            const RenderBatch &batch = batches[draw.batch];
+            size_t stride = draw.mesh->GetVertexSize();
+            size_t bytes = batch.packed ? batch.format.stride : stride * sizeof(float);
+            size_t &offset = draw.dynamic ? streamBytes : staticBytes;
+            offset = RoundUp(offset, bytes);
+            draw.baseVertex = offset / bytes;
+            offset += (size_t)draw.vertexCount * bytes;
+            if (draw.dynamic)
+            {
+                // En : Every segment must start at a vertex boundary of every dynamic mesh.
+                // Tr : Her bölüm her dinamik meshin bir vertex sınırında başlamalıdır.
+                streamAlignment = std::lcm(streamAlignment, bytes);
+                continue;
+            }
+            slabFloats = RoundUp(slabFloats, stride);
+            draw.slabOffset = slabFloats;
+            slabFloats += (size_t)draw.vertexCount * stride;
+        }
+        slab.Resize(slabFloats);
+        // En : Without a packed batch the vertex buffer is a copy of the slab, otherwise it is a copy of the packed vertices.
+        // Tr : Paketli batch yoksa vertex buffer slab'ın bir kopyasıdır, aksi halde paketli vertex'lerin bir kopyasıdır.
+        bool packed = false;
+        for (auto &batch : batches)
+            packed |= batch.packed;
+        if (packed)
+            packedVertices.resize(staticBytes);
+        else
+            packedVertices.clear();
+
+        // En : Every draw owns its ranges of the slab and the index block, so all of them are written in parallel.
+        // World matrices are resolved first, the threads only read them.
+        // Tr : Her çizim slab'daki ve index bloğundaki aralıklarına sahiptir, bu yüzden hepsi paralel yazılır.
+        // Dünya matrisleri önce çözülür, thread'ler yalnızca onları okur.
+        std::vector<unsigned int> indices(indexCount);
+        for (auto &draw : draws)
+            draw.mesh->GetTransform();
+        ParallelFor(draws.size(), [&](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            MeshDraw &draw = draws[i];
+                            if (!draw.dynamic)
+                                WriteVertices(draw, 0, draw.vertexCount);
+                            draw.uploadBegin = draw.uploadEnd = 0;
+                            WriteIndices(draw, indices.data());
+                        } }, drawBatch);
+
+        size_t vertexBytes = packed ? packedVertices.size() : slab.vertexSize * sizeof(float);
+        Reserve(vertexBlock, vertexBytes);
+        Reserve(indexBlock, indices.size() * sizeof(unsigned int));
+        if (vertexBytes)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, bufferPool->GetBuffer(vertexBlock));
+            glBufferSubData(GL_ARRAY_BUFFER, bufferPool->GetOffset(vertexBlock), vertexBytes,
+                            packed ? (const void *)packedVertices.data() : (const void *)slab.vertices.get());
+        }
+        stream.Resize(RoundUp(streamBytes, streamAlignment));
+        if (streamBytes)
+            StreamVertices();
+        LayoutObjects();
+
+        // En : Indices are written through the copy target, so no vertex array has to be bound.
+        // Tr : Index'ler kopyalama hedefi üzerinden yazılır, böylece hiçbir vertex dizisinin bağlı olması gerekmez.
+        if (!indices.empty())
+        {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, bufferPool->GetBuffer(indexBlock));
+            glBufferSubData(GL_COPY_WRITE_BUFFER, bufferPool->GetOffset(indexBlock), indices.size() * sizeof(unsigned int), indices.data());
+        }
+        for (auto &draw : draws)
+            draw.mesh->ClearChanges();
+
+        SetupVertexArrays();
+        layoutDirty = false;
+        bvhBuilt = false;
+    }
+    // En : Makes `block` hold at least `bytes`. A new block gets room to grow, so adding a mesh usually only rewrites
+    // the block. Blocks that became much larger than needed are given back. The contents are lost when the block changes.
+    // Tr : `block`'un en az `bytes` tutmasını sağlar. Yeni bir blok büyüme payı alır, böylece bir mesh eklemek genellikle
+    // yalnızca bloğu yeniden yazar. Gerekenden çok büyük kalan bloklar geri verilir. Blok değişirse içerik kaybolur.
+    void Scene::Reserve(BufferBlock &block, size_t bytes)
+    {
+        size_t size = bufferPool->GetSize(block);
+        if (bytes <= size && bytes >= size / 4)
+            return;
+        bufferPool->Free(block);
+        block = bufferPool->Allocate(bytes + bytes / 2);
+    }
+    // En : Creates the vertex array of every batch, static batches read their vertices from the start of the vertex block.
+    // Tr : Her batch'in vertex dizisini oluşturur, statik batch'ler vertex'lerini vertex bloğunun başından okur.
+    void Scene::SetupVertexArrays()
+    {
+        for (auto &batch : batches)
+        {
+            if (batch.vao)
+                glDeleteVertexArrays(1, &batch.vao);
+            glGenVertexArrays(1, &batch.vao);
+            glBindVertexArray(batch.vao);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.dynamic ? stream.GetBuffer() : bufferPool->GetBuffer(vertexBlock));
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferPool->GetBuffer(indexBlock));
+            if (batch.shader)
+                batch.shader->Activate(batch.packed ? &batch.format : nullptr, batch.dynamic ? 0 : bufferPool->GetOffset(vertexBlock));
+            if (batch.objectTransforms)
             {
-                indices.push_back(i[j] + offset);
+                glBindBuffer(GL_ARRAY_BUFFER, objectIndices);
+                glEnableVertexAttribArray(batch.objectLocation);
+                glVertexAttribIPointer(batch.objectLocation, 1, GL_UNSIGNED_INT, 0, (void *)batch.objectOffset);
             }
         }
+        glBindVertexArray(0);
+        bufferGeneration = bufferPool->GetGeneration();
+    }
+    // En : Writes the vertices [begin, end) of the mesh into its range of the slab and marks the bytes of the vertex buffer they cover for upload.
+    // Only the ranges of the draw are touched, so different draws can be written on different threads.
+    // Tr : Meshin [begin, end) vertex'lerini slab'daki aralığına yazar ve vertex buffer'ında kapladıkları baytları yükleme için işaretler.
+    // Yalnızca çizimin aralıklarına dokunulur, bu yüzden farklı çizimler farklı thread'lerde yazılabilir.
+    void Scene::WriteVertices(MeshDraw &draw, unsigned int begin, unsigned int end)
+    {
+        Mesh *mesh = draw.mesh;
+        const size_t stride = mesh->GetVertexSize();
+        float *destination = slab.vertices.get() + draw.slabOffset + begin * stride;
+        draw.transform = mesh->GetTransform();
+        WriteMeshVertices(draw, batches[draw.batch].normalOffset, destination, begin, end);
+        UpdateBounds(draw);
+
+        const RenderBatch &batch = batches[draw.batch];
+        size_t bytes = stride * sizeof(float);
+        if (batch.packed)
+        {
+            // En : The quantization range follows the bounds, so the whole mesh is encoded again.
+            // Tr : Nicemleme aralığı sınırları izler, bu yüzden tüm mesh yeniden kodlanır.
+            if (stride != batch.format.sourceSize)
+                return;
+            bytes = batch.format.stride;
+            begin = 0;
+            end = draw.vertexCount;
+            EncodeVertices(batch.format, draw.range, slab.vertices.get() + draw.slabOffset, draw.vertexCount,
+                           &packedVertices[(size_t)draw.baseVertex * bytes]);
+        }
+        else if (!packedVertices.empty())
+            std::memcpy(&packedVertices[((size_t)draw.baseVertex + begin) * bytes], destination, (size_t)(end - begin) * bytes);
 
-        if (vertices.size() != _vertexSize)
+        size_t uploadBegin = ((size_t)draw.baseVertex + begin) * bytes, uploadEnd = ((size_t)draw.baseVertex + end) * bytes;
+        if (draw.uploadBegin < draw.uploadEnd)
         {
-            if (!_vertices)
-                delete[] _vertices;
-            _vertices = new float[vertices.size()];
-            _vertexSize = vertices.size();
+            uploadBegin = std::min(uploadBegin, draw.uploadBegin);
+            uploadEnd = std::max(uploadEnd, draw.uploadEnd);
         }
-        if (indices.size() != _indexSize)
+        draw.uploadBegin = uploadBegin;
+        draw.uploadEnd = uploadEnd;
+    }
+    // En : Uploads the pending ranges of the static draws, the vertex buffer must be bound.
+    // Static draws are placed in order, so neighbouring ranges are merged while walking the draws.
+    // Tr : Statik çizimlerin bekleyen aralıklarını yükler, vertex buffer bağlı olmalıdır.
+    // Statik çizimler sırayla yerleştirilir, bu yüzden komşu aralıklar çizimler gezilirken birleştirilir.
+    void Scene::UploadVertices()
+    {
+        const unsigned char *source = packedVertices.empty() ? (const unsigned char *)slab.vertices.get() : packedVertices.data();
+        size_t base = bufferPool->GetOffset(vertexBlock), begin = 0, end = 0;
+        for (auto &draw : draws)
         {
-            if (!_indices)
-                delete[] _indices;
-            _indices = new unsigned int[indices.size()];
-            _indexSize = indices.size();
+            if (draw.uploadBegin >= draw.uploadEnd)
+                continue;
+            if (begin < end && draw.uploadBegin > end + uploadGap)
+            {
+                glBufferSubData(GL_ARRAY_BUFFER, base + begin, end - begin, source + begin);
+                begin = end;
+            }
+            if (begin >= end)
+                begin = draw.uploadBegin;
+            end = std::max(end, draw.uploadEnd);
+            draw.uploadBegin = draw.uploadEnd = 0;
         }
-        std::copy(vertices.begin(), vertices.end(), _vertices);
-        std::copy(indices.begin(), indices.end(), _indices);
+        if (begin < end)
+            glBufferSubData(GL_ARRAY_BUFFER, base + begin, end - begin, source + begin);
+    }
+    // En : Gives every batch with object transforms a region of the object index buffer and fills it with the draw index of each vertex.
+    // A region starts at or after the first vertex of its batch so the attribute offset is never negative, dynamic batches repeat
+    // their indices for every segment of the stream buffer. Also uploads the matrices of all draws.
+    // Tr : Nesne dönüşümlü her batch'e nesne indis buffer'ında bir bölge verir ve onu her vertex'in çizim indisi ile doldurur.
+    // Attribute ofseti asla negatif olmasın diye bir bölge batch'inin ilk vertex'inde ya da sonrasında başlar, dinamik batch'ler
+    // indislerini akış buffer'ının her bölümü için tekrarlar. Ayrıca tüm çizimlerin matrislerini yükler.
+    void Scene::LayoutObjects()
+    {
+        objectTransforms = false;
+        objectIndexBytes = 0;
+        std::vector<unsigned int> objects;
+        for (auto &batch : batches)
+        {
+            if (!batch.objectTransforms)
+                continue;
+            int index = &batch - batches.data();
+            size_t first = SIZE_MAX, last = 0, period = 0;
+            for (auto &draw : draws)
+            {
+                if (draw.batch != index)
+                    continue;
+                first = std::min(first, (size_t)draw.baseVertex);
+                last = std::max(last, (size_t)draw.baseVertex + draw.vertexCount);
+                period = stream.GetSegmentSize() / (draw.mesh->GetVertexSize() * sizeof(float));
+            }
+            if (first >= last)
+                continue;
+            int repeat = batch.dynamic ? stream.GetSegmentCount() : 1;
+            size_t start = std::max(objects.size(), first);
+            batch.objectOffset = (start - first) * sizeof(unsigned int);
+            objects.resize(start - first + (repeat - 1) * period + last);
+            for (unsigned int i = 0; i < draws.size(); i++)
+            {
+                const MeshDraw &draw = draws[i];
+                if (draw.batch != index)
+                    continue;
+                for (int segment = 0; segment < repeat; segment++)
+                {
+                    auto begin = objects.begin() + (start - first) + segment * period + draw.baseVertex;
+                    std::fill(begin, begin + draw.vertexCount, i);
+                }
+            }
+            objectTransforms = true;
+        }
+        if (!objectTransforms)
+            return;
+        glBindBuffer(GL_ARRAY_BUFFER, objectIndices);
+        glBufferData(GL_ARRAY_BUFFER, objects.size() * sizeof(unsigned int), objects.data(), GL_STATIC_DRAW);
+        objectIndexBytes = objects.size() * sizeof(unsigned int);
 
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), _vertices, GL_STATIC_DRAW);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), _indices, GL_STATIC_DRAW);
+        transforms.resize(draws.size());
+        for (size_t i = 0; i < draws.size(); i++)
+            transforms[i] = draws[i].transform;
+        glBindBuffer(GL_TEXTURE_BUFFER, transformBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, transforms.size() * sizeof(glm::mat4), transforms.data(), GL_DYNAMIC_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, transformTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, transformBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+    // En : Uploads the matrices of the local draws that moved since the last upload, runs closer than `uploadGap` are merged.
+    // Returns true if any matrix changed.
+    // Tr : Son yüklemeden beri hareket eden yerel çizimlerin matrislerini yükler, `uploadGap`'ten yakın diziler birleştirilir.
+    // Herhangi bir matris değiştiyse true döndürür.
+    bool Scene::UploadTransforms()
+    {
+        if (!objectTransforms)
+            return false;
+        glBindBuffer(GL_TEXTURE_BUFFER, transformBuffer);
+        const size_t gap = uploadGap / sizeof(glm::mat4);
+        size_t begin = 0, end = 0;
+        bool changed = false;
+        for (size_t i = 0; i < draws.size(); i++)
+        {
+            if (!draws[i].local || transforms[i] == draws[i].transform)
+                continue;
+            transforms[i] = draws[i].transform;
+            changed = true;
+            if (begin < end && i > end + gap)
+            {
+                glBufferSubData(GL_TEXTURE_BUFFER, begin * sizeof(glm::mat4), (end - begin) * sizeof(glm::mat4), &transforms[begin]);
+                begin = end;
+            }
+            if (begin >= end)
+                begin = i;
+            end = i + 1;
+        }
+        if (begin < end)
+            glBufferSubData(GL_TEXTURE_BUFFER, begin * sizeof(glm::mat4), (end - begin) * sizeof(glm::mat4), &transforms[begin]);
+        return changed;
+    }
+    // En : Writes the indices of every level of the mesh into its index block and records the levels.
+    // The block is copied into `indices` if it is not null, otherwise it is uploaded to the element buffer bound to the copy write target.
+    // Tr : Meshin her seviyesinin index'lerini index bloğuna yazar ve seviyeleri kaydeder.
+    // `indices` null değilse blok ona kopyalanır, aksi halde kopyalama yazma hedefine bağlı element buffer'a yüklenir.
+    void Scene::WriteIndices(MeshDraw &draw, unsigned int *indices)
+    {
+        Mesh *mesh = draw.mesh;
+        draw.levels.clear();
+        unsigned int offset = draw.indexOffset;
+        for (int level = -1; level < mesh->GetLODCount(); level++)
+        {
+            const std::vector<unsigned int> &i = level < 0 ? mesh->GetIndexData() : mesh->GetLOD(level).indices;
+            draw.levels.push_back({offset, (unsigned int)i.size()});
+            if (indices)
+                std::copy(i.begin(), i.end(), indices + offset);
+            else if (!i.empty())
+                glBufferSubData(GL_COPY_WRITE_BUFFER, bufferPool->GetOffset(indexBlock) + (size_t)offset * sizeof(unsigned int), i.size() * sizeof(unsigned int), i.data());
+            offset += i.size();
+        }
+    }
+    // En : Writes every dynamic mesh into the next segment of the stream buffer, the segment is written
+    // completely so it never holds the older vertices it was drawn with some frames ago.
+    // Tr : Her dinamik meshi akış buffer'ının sonraki bölümüne yazar, bölüm tamamen yazılır
+    // böylece birkaç kare önce çizildiği eski vertex'leri asla tutmaz.
+    void Scene::StreamVertices()
+    {
+        float *segment = (float *)stream.Map();
+        if (!segment)
+            return;
+        ParallelFor(draws.size(), [&](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            MeshDraw &draw = draws[i];
+                            if (!draw.dynamic)
+                                continue;
+                            Mesh *mesh = draw.mesh;
+                            draw.transform = mesh->GetTransform();
+                            WriteMeshVertices(draw, batches[draw.batch].normalOffset, segment + (size_t)draw.baseVertex * mesh->GetVertexSize(), 0, draw.vertexCount);
+                            UpdateBounds(draw);
+                        } }, drawBatch);
+        stream.Unmap();
+        bvhDirty = true;
+    }
+    void Scene::UpdateBounds(MeshDraw &draw)
+    {
+        AABB bounds = draw.mesh->GetWorldBounds();
+        draw.bounds = bounds;
+        drawBounds.Set(&draw - draws.data(), bounds);
+        if (!bounds.IsValid())
+            return;
+        BoundingSphere sphere = draw.mesh->GetWorldSphere();
+        draw.center = sphere.center;
+        draw.radius = sphere.radius;
+        if (draw.local)
+            bounds = draw.mesh->GetLocalBounds();
+        draw.range = CalculateQuantizationRange(bounds.min, bounds.max);
+    }
 
-        if (shader != nullptr && camera != nullptr)
+    void Scene::Update()
+    {
+        if (transformStore)
+            transformStore->UpdateWorldMatrices();
+        if (NeedsLayout())
+            Layout();
+        else
         {
-            shader->Use();
-            camera->SetUniforms(shader);
+            // En : Changed meshes are written on the CPU in parallel, the uploads are made afterwards on this thread.
+            // World matrices are cached along the hierarchy, they are resolved first so the parallel pass only reads them.
+            // Tr : Değişen meshler CPU'da paralel yazılır, yüklemeler ardından bu thread'de yapılır.
+            // Dünya matrisleri hiyerarşi boyunca önbelleğe alınır, paralel geçiş yalnızca okusun diye önce çözülürler.
+            for (auto &draw : draws)
+                draw.mesh->GetTransform();
+            std::atomic<bool> streamChanged(false);
+            ParallelFor(draws.size(), [&](size_t first, size_t last)
+                        {
+                            for (size_t i = first; i < last; i++)
+                            {
+                                MeshDraw &draw = draws[i];
+                                Mesh *mesh = draw.mesh;
+                                unsigned int begin, end;
+                                bool moved = mesh->GetTransform() != draw.transform;
+                                if (draw.dynamic)
+                                {
+                                    bool changed = (moved && !draw.local) || mesh->GetChangedVertices(begin, end);
+                                    if (changed)
+                                        streamChanged = true;
+                                    else if (moved)
+                                    {
+                                        draw.transform = mesh->GetTransform();
+                                        UpdateBounds(draw);
+                                    }
+                                    draw.idleFrames = changed ? 0 : draw.idleFrames + 1;
+                                    continue;
+                                }
+                                // En : A changed transform moves every vertex, otherwise only the edited vertices are written.
+                                // Local draws only take the new matrix, their vertices stay in mesh space.
+                                // Tr : Değişen bir dönüşüm her vertex'i taşır, aksi halde yalnızca düzenlenen vertex'ler yazılır.
+                                // Yerel çizimler yalnızca yeni matrisi alır, vertex'leri mesh uzayında kalır.
+                                bool changed = true;
+                                if (moved && draw.local && !mesh->GetChangedVertices(begin, end))
+                                {
+                                    draw.transform = mesh->GetTransform();
+                                    UpdateBounds(draw);
+                                    changed = false;
+                                }
+                                else if (moved)
+                                    WriteVertices(draw, 0, draw.vertexCount);
+                                else if (mesh->GetChangedVertices(begin, end))
+                                    WriteVertices(draw, begin, end);
+                                else
+                                    changed = false;
+                                draw.changedFrames = changed ? draw.changedFrames + 1 : 0;
+                            } }, drawBatch);
+            for (auto &draw : draws)
+            {
+                if (draw.promoted && draw.idleFrames >= staticThreshold)
+                {
+                    draw.promoted = false;
+                    layoutDirty = true;
+                }
+                if (draw.dynamic || !draw.changedFrames)
+                    continue;
+                bvhDirty = true;
+                if (draw.changedFrames >= dynamicThreshold)
+                {
+                    draw.promoted = true;
+                    layoutDirty = true;
+                }
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, bufferPool->GetBuffer(vertexBlock));
+            UploadVertices();
+            if (streamChanged)
+                StreamVertices();
+            if (UploadTransforms())
+                bvhDirty = true;
+            glBindBuffer(GL_COPY_WRITE_BUFFER, bufferPool->GetBuffer(indexBlock));
+            for (auto &draw : draws)
+            {
+                Mesh *mesh = draw.mesh;
+                if (mesh->HasIndexChanges())
+                {
+                    WriteIndices(draw, nullptr);
+                    hasLODs = false;
+                    for (auto &other : draws)
+                        hasLODs |= other.levels.size() > 1;
+                }
+                mesh->ClearChanges();
+            }
+        }
+
+        if (camera != nullptr)
+        {
+            if (shader != nullptr)
+            {
+                shader->Use();
+                camera->SetUniforms(shader);
+            }
+            for (int i = 0; i < (int)batches.size(); i++)
+            {
+                Shader *other = batches[i].shader;
+                if (batches[i].program != i || !other || other == shader)
+                    continue;
+                other->Use();
+                camera->SetUniforms(other);
+            }
+        }
+    }
+    // En : Rasterizes the largest visible meshes into the occlusion buffer and clears the visibility of the draws hidden behind them.
+    // The occluders themselves stay visible. Returns the number of hidden draws.
+    // Tr : En büyük görünür meshleri örtme buffer'ına rasterleştirir ve arkalarında gizli çizimlerin görünürlüğünü kaldırır.
+    // Örtenlerin kendileri görünür kalır. Gizli çizimlerin sayısını döndürür.
+    size_t Scene::CullOccluded(const glm::mat4 &viewProjection)
+    {
+        std::vector<std::pair<float, unsigned int>> candidates;
+        for (unsigned int i = 0; i < draws.size(); i++)
+        {
+            const MeshDraw &draw = draws[i];
+            if (!visibility[i] || draw.mesh->GetIndexData().size() / 3 > occluderBudget)
+                continue;
+            float size = camera->GetScreenSize(draw.center, draw.radius);
+            if (size >= occluderSize)
+                candidates.push_back({size, i});
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const std::pair<float, unsigned int> &a, const std::pair<float, unsigned int> &b)
+                  { return a.first > b.first; });
+        occluders.clear();
+        occluderDraws.clear();
+        size_t triangles = 0;
+        for (auto &candidate : candidates)
+        {
+            const MeshDraw &draw = draws[candidate.second];
+            size_t count = draw.mesh->GetIndexData().size() / 3;
+            if (triangles + count > occluderBudget)
+                continue;
+            triangles += count;
+            Occluder occluder;
+            occluder.mesh = draw.mesh;
+            occluder.transform = draw.transform;
+            occluders.push_back(occluder);
+            occluderDraws.push_back(candidate.second);
+        }
+        cullStats.occluders = occluders.size();
+        if (occluders.empty())
+            return 0;
+        size_t before = std::count(visibility.begin(), visibility.end(), 1);
+        occlusion.Clear(viewProjection);
+        occlusion.Render(occluders);
+        size_t after = occlusion.CullBoxes(drawBounds, visibility);
+        for (unsigned int draw : occluderDraws)
+            after += !visibility[draw];
+        for (unsigned int draw : occluderDraws)
+            visibility[draw] = 1;
+        return before - after;
+    }
+    // En : Fills the render queue with the visible level of every mesh inside the frustum and sorts it.
+    // Tr : Render kuyruğunu görüş piramidi içindeki her meshin görünen seviyesi ile doldurur ve sıralar.
+    void Scene::BuildQueue()
+    {
+        queue.clear();
+        bool selectLOD = hasLODs && camera;
+        glm::mat4 view = camera ? camera->GetViewMatrix() : glm::mat4(1.0f);
+        glm::mat4 viewProjection = camera ? camera->GetProjectionMatrix() * view : glm::mat4(1.0f);
+        cullStats = CullStats();
+        size_t visible = draws.size();
+        if (frustumCulling && camera)
+            visible = CullBoxes(CreateFrustum(viewProjection), drawBounds, visibility);
+        else
+            visibility.assign(draws.size(), 1);
+        cullStats.culled = draws.size() - visible;
+        if (occlusionCulling && camera)
+            cullStats.occluded = CullOccluded(viewProjection);
+        for (unsigned int i = 0; i < draws.size(); i++)
+        {
+            const MeshDraw &draw = draws[i];
+            if (!visibility[i])
+                continue;
+            int level = selectLOD ? draw.mesh->SelectLOD(camera->GetScreenSize(draw.center, draw.radius)) : 0;
+            if (!draw.levels[level].count)
+                continue;
+            // En : The bits of a non negative float sort like the float, so the nearest point of the sphere is the depth.
+            // Tr : Negatif olmayan bir float'ın bitleri float gibi sıralanır, bu yüzden kürenin en yakın noktası derinliktir.
+            float depth = camera ? std::max(-(view * glm::vec4(draw.center, 1.0f)).z - draw.radius, 0.0f) : 0.0f;
+            uint32_t depthBits;
+            std::memcpy(&depthBits, &depth, sizeof(depthBits));
+            const RenderBatch &batch = batches[draw.batch];
+            RenderItem item;
+            item.key = (uint64_t)(batch.program & 0xFFFF) << 48 | (uint64_t)(draw.batch & 0xFFFF) << 32 | depthBits;
+            item.draw = i;
+            item.level = level;
+            queue.push_back(item);
         }
+        cullStats.visible = queue.size();
+        std::sort(queue.begin(), queue.end(), [](const RenderItem &a, const RenderItem &b)
+                  { return a.key < b.key; });
     }
     void Scene::Draw()
     {
-        glBindVertexArray(vao);
-        if (shader)
-            shader->Use();
-        glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+        BuildQueue();
+        if (bufferGeneration != bufferPool->GetGeneration())
+            SetupVertexArrays();
+        int program = -1, current = -1;
+        bool streamed = false, indirect = GetIndirectDraw();
+        const unsigned int firstIndex = bufferPool->GetOffset(indexBlock) / sizeof(unsigned int);
+        size_t submitted = 0, pending = 0;
+        drawCounts.clear();
+        drawOffsets.clear();
+        drawBaseVertices.clear();
+        if (objectTransforms)
+        {
+            glActiveTexture(GL_TEXTURE0 + objectTransformUnit);
+            glBindTexture(GL_TEXTURE_BUFFER, transformTexture);
+            glActiveTexture(GL_TEXTURE0);
+        }
+        bool lighting = camera && !lights.empty();
+        glm::vec2 viewport(1.0f);
+        if (lighting)
+        {
+            GLint rectangle[4];
+            glGetIntegerv(GL_VIEWPORT, rectangle);
+            viewport = glm::vec2(rectangle[2], rectangle[3]);
+            lightGrid.Assign(lights, camera->GetViewMatrix(), camera->GetProjectionMatrix());
+            lightGrid.Upload();
+            lightGrid.Bind(lightUnit);
+        }
+        // En : Every segment holds all dynamic meshes, the current one starts at the segment offset.
+        // Tr : Her bölüm tüm dinamik meshleri tutar, geçerli bölüm bölüm ofsetinde başlar.
+        auto baseVertexOf = [this](const MeshDraw &draw)
+        {
+            unsigned int baseVertex = draw.baseVertex;
+            if (draw.dynamic)
+                baseVertex += stream.GetOffset() / (draw.mesh->GetVertexSize() * sizeof(float));
+            return baseVertex;
+        };
+        // En : The commands of every batch are written in queue order and uploaded at once, each batch then draws its own run of them.
+        // Tr : Her batch'in komutları kuyruk sırasında yazılır ve tek seferde yüklenir, ardından her batch kendi komut dizisini çizer.
+        if (indirect)
+        {
+            drawCommands.clear();
+            for (auto &item : queue)
+            {
+                const MeshDraw &draw = draws[item.draw];
+                if (batches[draw.batch].packed)
+                    continue;
+                const DrawRange &range = draw.levels[item.level];
+                DrawCommand command;
+                command.count = range.count;
+                command.firstIndex = firstIndex + range.offset;
+                command.baseVertex = baseVertexOf(draw);
+                drawCommands.push_back(command);
+            }
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, drawCommands.size() * sizeof(DrawCommand), drawCommands.data(), GL_STREAM_DRAW);
+        }
+        // En : Sends the merged draws of the current batch.
+        // Tr : Geçerli batch'in birleştirilmiş çizimlerini gönderir.
+        auto flush = [&]()
+        {
+            if (indirect)
+            {
+                if (pending)
+                    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void *)(submitted * sizeof(DrawCommand)), pending, 0);
+                submitted += pending;
+                pending = 0;
+                return;
+            }
+            if (drawCounts.empty())
+                return;
+            glMultiDrawElementsBaseVertex(GL_TRIANGLES, drawCounts.data(), GL_UNSIGNED_INT, drawOffsets.data(), drawCounts.size(), drawBaseVertices.data());
+            drawCounts.clear();
+            drawOffsets.clear();
+            drawBaseVertices.clear();
+        };
+        for (auto &item : queue)
+        {
+            const MeshDraw &draw = draws[item.draw];
+            const RenderBatch &batch = batches[draw.batch];
+            if (draw.batch != current)
+            {
+                flush();
+                current = draw.batch;
+                glBindVertexArray(batch.vao);
+                if (batch.program != program && batch.shader)
+                {
+                    batch.shader->Use();
+                    if (batch.shader->GetUniforms().count("lightCount"))
+                    {
+                        if (lighting)
+                            lightGrid.SetUniforms(batch.shader, lightUnit, viewport);
+                        else
+                            batch.shader->Set("lightCount", 0);
+                    }
+                }
+                program = batch.program;
+                if (batch.shader && !batch.packed)
+                {
+                    batch.shader->Set("positionScale", glm::vec3(1.0f));
+                    batch.shader->Set("positionBias", glm::vec3(0.0f));
+                }
+                if (batch.shader)
+                    batch.shader->Set(useObjectTransformsName, batch.objectTransforms);
+                if (batch.objectTransforms)
+                    batch.shader->Set(objectTransformsName, objectTransformUnit);
+            }
+            streamed |= draw.dynamic;
+            if (indirect && !batch.packed)
+            {
+                pending++;
+                continue;
+            }
+            const DrawRange &range = draw.levels[item.level];
+            const void *offset = (const void *)((size_t)(firstIndex + range.offset) * sizeof(unsigned int));
+            unsigned int baseVertex = baseVertexOf(draw);
+            if (batch.packed)
+            {
+                batch.shader->Set("positionScale", draw.range.scale);
+                batch.shader->Set("positionBias", draw.range.bias);
+                glDrawElementsBaseVertex(GL_TRIANGLES, range.count, GL_UNSIGNED_INT, (void *)offset, baseVertex);
+                continue;
+            }
+            drawCounts.push_back(range.count);
+            drawOffsets.push_back(offset);
+            drawBaseVertices.push_back(baseVertex);
+        }
+        flush();
+        glBindVertexArray(0);
+        if (indirect)
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        if (streamed)
+            stream.Fence();
     }
 }
 #endif
\ No newline at end of file
@@ -2,36 +2,218 @@
 #define SCENE_H
 
 #include <vector>
+#include <memory>
+#include <cstdint>
 #include <GL/glew.h>
 
 #include "Object.h"
 #include "Mesh.h"
 #include "Shader.h"
 #include "Camera.h"
+#include "StreamBuffer.h"
+#include "Frustum.h"
+#include "Occlusion.h"
+#include "BVH.h"
+#include "BufferPool.h"
+#include "Animation.h"
+#include "Light.h"
 
 namespace parseShape
 {
+    // En : A range of indices in the element buffer of the scene.
+    // Tr : Sahnenin element buffer'ındaki bir index aralığı.
+    struct DrawRange
+    {
+        unsigned int offset = 0, count = 0;
+    };
+    // En : One command of glMultiDrawElementsIndirect, the layout is fixed by OpenGL.
+    // Tr : glMultiDrawElementsIndirect'in bir komutu, düzeni OpenGL tarafından belirlenir.
+    struct DrawCommand
+    {
+        GLuint count = 0, instanceCount = 1, firstIndex = 0;
+        GLint baseVertex = 0;
+        GLuint baseInstance = 0;
+    };
+    // En : Draw information of a mesh, `levels` holds a range for every level of detail.
+    // The indices are not rebased, they are drawn with `baseVertex`.
+    // Tr : Bir meshin çizim bilgisi, `levels` her detay seviyesi için bir aralık tutar.
+    // Index'ler kaydırılmaz, `baseVertex` ile çizilirler.
+    struct MeshDraw
+    {
+        Mesh *mesh = nullptr;
+        glm::vec3 center = glm::vec3(0.0f);
+        float radius = 0.0f;
+        // En : `baseVertex` is counted in vertices of the mesh's own stride from the start of its buffer,
+        // `slabOffset` is the float offset of a static mesh in the slab.
+        // Tr : `baseVertex` meshin kendi adımındaki vertex'lerle buffer'ının başından sayılır,
+        // `slabOffset` statik bir meshin slab'daki float ofsetidir.
+        unsigned int baseVertex = 0, vertexCount = 0;
+        size_t slabOffset = 0;
+        int batch = 0;
+        // En : Index block of the mesh, the full detail indices are followed by the lower levels.
+        // Tr : Meshin index bloğu, tam detaylı index'leri düşük seviyeler izler.
+        unsigned int indexOffset = 0, indexCount = 0;
+        std::vector<DrawRange> levels;
+        QuantizationRange range;
+        AABB bounds;
+        // En : The transform the vertices were last written with. Draws with `local` set keep their vertices in mesh space
+        // and the transform is applied by the vertex shader instead.
+        // Tr : Vertex'lerin en son yazıldığı dönüşüm. `local` ayarlı çizimler vertex'lerini mesh uzayında tutar
+        // ve dönüşüm bunun yerine vertex shader tarafından uygulanır.
+        glm::mat4 transform = glm::mat4(0.0f);
+        bool local = false;
+        // En : Dynamic draws live in the stream buffer, `baseVertex` is then relative to the current segment.
+        // `changedFrames` counts the consecutive updates that rewrote a static draw. `promoted` draws were made dynamic by the
+        // scene, not by their mesh, and `idleFrames` counts the consecutive updates that left them unchanged.
+        // Tr : Dinamik çizimler akış buffer'ında durur, `baseVertex` bu durumda geçerli bölüme görelidir.
+        // `changedFrames` statik bir çizimi yeniden yazan art arda güncellemeleri sayar. `promoted` çizimler meshleri değil
+        // sahne tarafından dinamik yapılmıştır, `idleFrames` onları değiştirmeyen art arda güncellemeleri sayar.
+        bool dynamic = false, promoted = false;
+        unsigned int changedFrames = 0, idleFrames = 0;
+        // En : Byte range of the static vertex buffer that was written on the CPU but is not uploaded yet.
+        // Tr : Statik vertex buffer'ının CPU'da yazılmış ama henüz yüklenmemiş bayt aralığı.
+        size_t uploadBegin = 0, uploadEnd = 0;
+    };
+
+    // En : Meshes that share a shader and a vertex buffer, they are drawn through one vertex array.
+    // Tr : Bir shader'ı ve bir vertex buffer'ı paylaşan meshler, tek bir vertex dizisi ile çizilirler.
+    struct RenderBatch
+    {
+        Shader *shader = nullptr;
+        bool dynamic = false, packed = false;
+        GLuint vao = 0;
+        // En : Index of the first batch with the same shader, batches are sorted by it to switch programs once.
+        // Tr : Aynı shader'a sahip ilk batch'in indisi, programlar bir kez değişsin diye batch'ler buna göre sıralanır.
+        int program = 0;
+        VertexFormat format;
+        // En : True if the shader reads per object transforms, its vertices then read their draw index from the object index buffer
+        // at `objectOffset + vertex * 4` through the attribute at `objectLocation`.
+        // Tr : Shader nesne başına dönüşümleri okuyorsa true, vertex'leri bu durumda çizim indislerini `objectLocation`'daki
+        // attribute ile nesne indis buffer'ında `objectOffset + vertex * 4` konumundan okur.
+        bool objectTransforms = false;
+        GLint objectLocation = -1;
+        size_t objectOffset = 0;
+        // En : Float offset of the normal attribute of the shader, -1 if it has none. Baked vertices turn their normals with the mesh.
+        // Tr : Shader'ın normal attribute'unun float ofseti, yoksa -1. Hazır vertex'ler normallerini meshle birlikte döndürür.
+        int normalOffset = -1;
+    };
+    // En : An entry of the render queue, `key` orders by program, then vertex array, then depth front to back.
+    // Tr : Render kuyruğunun bir elemanı, `key` önce programa, sonra vertex dizisine, sonra önden arkaya derinliğe göre sıralar.
+    struct RenderItem
+    {
+        uint64_t key = 0;
+        unsigned int draw = 0;
+        int level = 0;
+    };
+
+    // En : Number of meshes drawn, skipped by frustum culling and skipped by occlusion culling in the last frame.
+    // `occluders` is the number of meshes rasterized into the occlusion buffer.
+    // Tr : Son karede çizilen, görüş piramidi ayıklamasıyla atlanan ve örtme ayıklamasıyla atlanan mesh sayısı.
+    // `occluders` örtme buffer'ına rasterleştirilen mesh sayısıdır.
+    struct CullStats
+    {
+        unsigned int visible = 0, culled = 0, occluded = 0, occluders = 0;
+    };
+
+    // En : Scene wide storage for the world space vertices of every mesh, each mesh owns a range of it.
+    // The storage only grows, so an update writes every value once and nothing is zero filled.
+    // Indices are copied from the meshes unchanged since they are never rebased.
+    // Tr : Her meshin dünya uzayındaki vertex'leri için sahne çapında depolama, her mesh bir aralığına sahiptir.
+    // Depolama yalnızca büyür, böylece bir güncelleme her değeri bir kez yazar ve hiçbir şey sıfırla doldurulmaz.
+    // Index'ler asla kaydırılmadığı için meshlerden değiştirilmeden kopyalanır.
+    struct GeometrySlab
+    {
+        std::unique_ptr<float[]> vertices;
+        size_t vertexCapacity = 0, vertexSize = 0;
+
+        // En : Sets the used float count, the contents are kept only if there is enough capacity.
+        // Tr : Kullanılan float sayısını ayarlar, içerik yalnızca yeterli kapasite varsa korunur.
+        void Resize(size_t vertexSize);
+    };
+
     // En : Scene class is used to manage the objects and meshes in the scene.
     // Tr : Scene sınıfı, sahnedeki nesneleri ve mesh'leri yönetmek için kullanılır.
     class Scene
     {
     private:
-        GLuint vao, vbo, ebo;
+        // En : The static vertices and the indices live in blocks of a shared buffer pool, `bufferGeneration` is the pool generation
+        // the vertex arrays were set up with.
+        // Tr : Statik vertex'ler ve index'ler paylaşılan bir buffer havuzunun bloklarında durur, `bufferGeneration` vertex
+        // dizilerinin kurulduğu havuz kuşağıdır.
+        BufferPool *bufferPool;
+        BufferBlock vertexBlock, indexBlock;
+        uint32_t bufferGeneration = 0;
+        StreamBuffer stream;
+        unsigned int dynamicVertexCount = 0;
         std::vector<Object *> objects;
         std::vector<Mesh *> meshes;
-        Shader *shader;
-        Camera *camera;
+        Shader *shader = nullptr;
+        Camera *camera = nullptr;
+        TransformStore *transformStore = nullptr;
+        Animator animator;
+        // En : Point lights of the scene, assigned to the cells of the camera frustum before every draw.
+        // Tr : Sahnenin nokta ışıkları, her çizimden önce kamera görüş piramidinin hücrelerine atanır.
+        std::vector<Light *> lights;
+        LightGrid lightGrid;
+
+        GeometrySlab slab;
+        std::vector<MeshDraw> draws;
+        std::vector<RenderBatch> batches;
+        std::vector<RenderItem> queue;
+        // En : World bounds of the draws in the same order, tested against the frustum in batches.
+        // Tr : Aynı sıradaki çizimlerin dünya sınırları, görüş piramidine karşı toplu olarak test edilir.
+        BoxArray drawBounds;
+        std::vector<unsigned char> visibility;
+        bool frustumCulling = true, occlusionCulling = true;
+        CullStats cullStats;
+        OcclusionBuffer occlusion;
+        std::vector<Occluder> occluders;
+        std::vector<unsigned int> occluderDraws;
+        // En : The tree is built on first use after a layout and refitted when a mesh was written since the last query.
+        // Tr : Ağaç bir yerleşimden sonraki ilk kullanımda oluşturulur ve son sorgudan beri bir mesh yazıldıysa yeniden uydurulur.
+        BVH bvh;
+        bool bvhBuilt = false, bvhDirty = false;
+        // En : One world matrix per draw in a texture buffer, `transforms` is what the GPU holds.
+        // Tr : Bir doku buffer'ında çizim başına bir dünya matrisi, `transforms` GPU'nun tuttuğudur.
+        GLuint objectIndices, transformBuffer, transformTexture;
+        std::vector<glm::mat4> transforms;
+        size_t objectIndexBytes = 0;
+        bool objectTransforms = false;
+        unsigned int indexCount = 0;
+        bool hasLODs = false, layoutDirty = true;
+        std::vector<GLsizei> drawCounts;
+        std::vector<const void *> drawOffsets;
+        std::vector<GLint> drawBaseVertices;
+        // En : Commands of the visible draws of the frame, uploaded once into `indirectBuffer` when indirect draws are used.
+        // Tr : Karenin görünür çizimlerinin komutları, dolaylı çizimler kullanıldığında `indirectBuffer`'a bir kez yüklenir.
+        std::vector<DrawCommand> drawCommands;
+        GLuint indirectBuffer = 0;
+        bool indirectDraw = true, indirectSupported = false;
 
-        std::vector<float> vertices;
-        std::vector<unsigned int> indices;
-        int vertexSize, indexSize;
+        bool quantized = false;
+        VertexEncoding positionEncoding = VertexEncoding::Snorm16;
+        std::vector<unsigned char> packedVertices;
 
-        float *_vertices = nullptr;
-        unsigned int *_indices = nullptr;
-        int _vertexSize = 0, _indexSize = 0;
+        bool NeedsLayout() const;
+        void Layout();
+        void WriteVertices(MeshDraw &draw, unsigned int begin, unsigned int end);
+        void UploadVertices();
+        void LayoutObjects();
+        bool UploadTransforms();
+        void WriteIndices(MeshDraw &draw, unsigned int *indices);
+        void StreamVertices();
+        void DeleteBatches();
+        void Reserve(BufferBlock &block, size_t bytes);
+        void SetupVertexArrays();
+        int FindBatch(Shader *shader, bool dynamic);
+        void BuildQueue();
+        size_t CullOccluded(const glm::mat4 &viewProjection);
+        void UpdateBounds(MeshDraw &draw);
 
     public:
-        Scene();
+        // En : The static geometry is suballocated from `bufferPool`, the pool shared by all scenes is used if it is null.
+        // Tr : Statik geometri `bufferPool`'dan ayrılır, null ise tüm sahnelerin paylaştığı havuz kullanılır.
+        Scene(BufferPool *bufferPool = nullptr);
         ~Scene();
 
         // En : Sets shader for the scene.
@@ -61,12 +243,79 @@ namespace parseShape
         // En : Returns the meshes in the scene.
         // Tr : Sahnedeki mesh'leri döner.
         std::vector<Mesh *> GetMeshes() const;
-        // En : Sets the vertices and indices for the scene.
-        // Tr : Sahne için vertex ve index ayarlar.
+        // En : Attaches the objects and meshes of the scene to `store`, objects added later are attached too.
+        // Update then recalculates all world matrices in one pass over the store. A null store detaches them.
+        // Tr : Sahnenin nesnelerini ve meshlerini `store`'a bağlar, sonradan eklenen nesneler de bağlanır.
+        // Update bu durumda tüm dünya matrislerini depo üzerinde tek geçişte yeniden hesaplar. Null bir depo onları ayırır.
+        void SetTransformStore(TransformStore *store);
+        TransformStore *GetTransformStore() const;
+        // En : Returns the animation tracks of the scene, the caller advances them before Update.
+        // Tr : Sahnenin animasyon izlerini döndürür, çağıran onları Update'ten önce ilerletir.
+        Animator &GetAnimator();
+        // En : Returns the point lights added to the scene.
+        // Tr : Sahneye eklenen nokta ışıkları döndürür.
+        const std::vector<Light *> &GetLights() const;
+        // En : Returns the light lists of the cells of the last frame.
+        // Tr : Son karenin hücrelerinin ışık listelerini döndürür.
+        const LightGrid &GetLightGrid() const;
+        // En : Uploads the vertices in a compact format: quantized positions, 10_10_10_2 normals and 8 bit colors.
+        // The shader must decode the position with the `positionScale` and `positionBias` uniforms.
+        // Tr : Vertex'leri sıkıştırılmış formatta yükler: nicemlenmiş konumlar, 10_10_10_2 normaller ve 8 bit renkler.
+        // Shader konumu `positionScale` ve `positionBias` uniform'ları ile çözmelidir.
+        void SetQuantized(bool quantized, VertexEncoding positionEncoding = VertexEncoding::Snorm16);
+        // En : Returns the packed vertex format of the scene shader, or null if the scene uploads floats.
+        // The vertex arrays of the scene are set up by the scene itself.
+        // Tr : Sahne shader'ının paketlenmiş vertex formatını döndürür, sahne float yüklüyorsa null döner.
+        // Sahnenin vertex dizileri sahnenin kendisi tarafından kurulur.
+        const VertexFormat *GetVertexFormat() const;
+        // En : Uploads the changes of the meshes, only the changed ranges are written.
+        // The buffers are rebuilt only if a mesh was added or its vertex or index count changed.
+        // Dynamic meshes are written into the next segment of the stream buffer whenever one of them changes,
+        // a static mesh that changes in several updates in a row is made dynamic.
+        // Tr : Meshlerin değişikliklerini yükler, yalnızca değişen aralıklar yazılır.
+        // Buffer'lar yalnızca bir mesh eklendiyse ya da vertex veya index sayısı değiştiyse yeniden oluşturulur.
+        // Dinamik meshlerden biri değiştiğinde hepsi akış buffer'ının sonraki bölümüne yazılır,
+        // art arda birkaç güncellemede değişen statik bir mesh dinamik yapılır.
         void Update();
-        // En : Draws the scene.
-        // Tr : Sahneyi çizer.
+        // En : Draws the scene, meshes with levels of detail are drawn with the level that fits their screen size.
+        // Draws are sorted by shader, vertex array and depth, and neighbours that need no uniform change are merged
+        // into one call, so every shader is bound once per frame. Shaders that declare `lightCount` get the lights
+        // of the scene as lists per cell of the frustum.
+        // Tr : Sahneyi çizer, detay seviyesi olan meshler ekran boyutlarına uyan seviye ile çizilir.
+        // Çizimler shader'a, vertex dizisine ve derinliğe göre sıralanır ve uniform değişikliği gerektirmeyen komşular
+        // tek çağrıda birleştirilir, böylece her shader karede bir kez bağlanır. `lightCount` tanımlayan shader'lar
+        // sahnenin ışıklarını görüş piramidinin hücre başına listeleri olarak alır.
         void Draw();
+        // En : Enables skipping the meshes whose world bounds are outside the view of the camera, it is enabled by default.
+        // Tr : Dünya sınırları kameranın görüşü dışında kalan meshlerin atlanmasını etkinleştirir, varsayılan olarak etkindir.
+        void SetFrustumCulling(bool frustumCulling);
+        bool GetFrustumCulling() const;
+        // En : Enables skipping the meshes hidden behind the largest meshes on screen, it is enabled by default.
+        // The test runs on the CPU against a low resolution depth buffer, so no GPU readback is needed.
+        // Tr : Ekrandaki en büyük meshlerin arkasında gizli meshlerin atlanmasını etkinleştirir, varsayılan olarak etkindir.
+        // Test CPU'da düşük çözünürlüklü bir derinlik buffer'ına karşı yapılır, böylece GPU'dan okuma gerekmez.
+        void SetOcclusionCulling(bool occlusionCulling);
+        bool GetOcclusionCulling() const;
+        const OcclusionBuffer &GetOcclusionBuffer() const;
+        CullStats GetCullStats() const;
+        // En : Enables submitting the draws of a batch from a buffer of commands with glMultiDrawElementsIndirect, it is enabled
+        // by default. Without OpenGL 4.3 or ARB_multi_draw_indirect the arrays of glMultiDrawElementsBaseVertex are used instead.
+        // Tr : Bir batch'in çizimlerini glMultiDrawElementsIndirect ile bir komut buffer'ından göndermeyi etkinleştirir, varsayılan
+        // olarak etkindir. OpenGL 4.3 ya da ARB_multi_draw_indirect yoksa bunun yerine glMultiDrawElementsBaseVertex dizileri kullanılır.
+        void SetIndirectDraw(bool indirectDraw);
+        // En : Returns true if draws are submitted with indirect commands, which also requires the context to support them.
+        // Tr : Çizimler dolaylı komutlarla gönderiliyorsa true döndürür, bu ayrıca bağlamın onları desteklemesini gerektirir.
+        bool GetIndirectDraw() const;
+        // En : Returns the bytes of the buffers the scene holds on the GPU as of the last Update.
+        // Tr : Sahnenin GPU'da tuttuğu buffer'ların son Update'teki bayt sayısını döndürür.
+        size_t GetGPUMemory() const;
+        BufferPool *GetBufferPool() const;
+        // En : Returns the triangle hierarchy of the meshes as of the last Update, for picking and spatial queries.
+        // Tr : Seçim ve uzamsal sorgular için meshlerin son Update'teki üçgen hiyerarşisini döndürür.
+        const BVH &GetBVH();
+        // En : Returns the closest triangle hit by the ray.
+        // Tr : Işının çarptığı en yakın üçgeni döndürür.
+        BVHHit Pick(const Ray &ray);
     };
 }
 
@@ -0,0 +1,149 @@
+#ifndef SCENECACHE_CPP
+#define SCENECACHE_CPP
+
+#include "SceneCache.h"
+#include "Parser.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace parseShape
+{
+#pragma region Constructors and Destructors
+    SceneCache::SceneCache(size_t budget) : budget(budget)
+    {
+    }
+    SceneCache::~SceneCache()
+    {
+        Clear();
+    }
+#pragma endregion
+#pragma region Scenes
+    Scene *SceneCache::Get(const std::string &path)
+    {
+        auto entry = std::find_if(entries.begin(), entries.end(), [&](const Entry &entry)
+                                  { return entry.path == path; });
+        if (entry != entries.end())
+        {
+            entry->lastUse = ++useCount;
+            Trim();
+            return entry->scene;
+        }
+        Scene *scene = Parse(path);
+        if (!scene)
+            return nullptr;
+        scene->Update();
+        Entry created{path, scene, scene->GetGPUMemory(), ++useCount};
+        Own(created);
+        entries.push_back(std::move(created));
+        Trim();
+        return scene;
+    }
+    bool SceneCache::Contains(const std::string &path) const
+    {
+        return std::any_of(entries.begin(), entries.end(), [&](const Entry &entry)
+                           { return entry.path == path; });
+    }
+    // En : Records the objects, the camera and every distinct shader of a freshly parsed scene, objects added to the scene
+    // later belong to whoever added them.
+    // Tr : Yeni ayrıştırılmış bir sahnenin nesnelerini, kamerasını ve her farklı shader'ını kaydeder, sahneye sonradan
+    // eklenen nesneler onları ekleyene aittir.
+    void SceneCache::Own(Entry &entry)
+    {
+        std::unordered_set<Object *> objects;
+        std::unordered_set<Shader *> shaders;
+        auto addObject = [&](Object *object)
+        {
+            if (object && objects.insert(object).second)
+                entry.objects.push_back(object);
+        };
+        auto addShader = [&](Shader *shader)
+        {
+            if (shader && shaders.insert(shader).second)
+                entry.shaders.push_back(shader);
+        };
+        for (Object *object : entry.scene->GetObjects())
+            addObject(object);
+        for (Mesh *mesh : entry.scene->GetMeshes())
+        {
+            addObject(mesh);
+            addShader(mesh->GetShader());
+        }
+        addObject(entry.scene->GetCamera());
+        addShader(entry.scene->GetShader());
+    }
+    // En : The scene goes first, it still points to the objects and the shaders until it is deleted.
+    // Tr : Önce sahne silinir, silinene kadar hâlâ nesneleri ve shader'ları gösterir.
+    void SceneCache::Release(Entry &entry)
+    {
+        delete entry.scene;
+        for (Object *object : entry.objects)
+            delete object;
+        for (Shader *shader : entry.shaders)
+            delete shader;
+        entry.objects.clear();
+        entry.shaders.clear();
+    }
+    void SceneCache::Evict(const std::string &path)
+    {
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (entries[i].path != path)
+                continue;
+            Release(entries[i]);
+            entries.erase(entries.begin() + i);
+            return;
+        }
+    }
+    void SceneCache::Clear()
+    {
+        for (auto &entry : entries)
+            Release(entry);
+        entries.clear();
+    }
+    // En : Scenes may grow while they are viewed, so their memory is read again before the least recently used are deleted.
+    // Tr : Sahneler görüntülenirken büyüyebilir, bu yüzden en uzun süredir kullanılmayanlar silinmeden önce bellekleri yeniden okunur.
+    void SceneCache::Trim()
+    {
+        size_t memory = 0;
+        for (auto &entry : entries)
+        {
+            entry.memory = entry.scene->GetGPUMemory();
+            memory += entry.memory;
+        }
+        while (memory > budget && entries.size() > 1)
+        {
+            auto oldest = std::min_element(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+                                           { return a.lastUse < b.lastUse; });
+            if (oldest->lastUse == useCount)
+                break;
+            memory -= oldest->memory;
+            Release(*oldest);
+            entries.erase(oldest);
+        }
+    }
+#pragma endregion
+#pragma region Budget
+    void SceneCache::SetBudget(size_t budget)
+    {
+        this->budget = budget;
+        Trim();
+    }
+    size_t SceneCache::GetBudget() const
+    {
+        return budget;
+    }
+    size_t SceneCache::GetMemory() const
+    {
+        size_t memory = 0;
+        for (auto &entry : entries)
+            memory += entry.memory;
+        return memory;
+    }
+    size_t SceneCache::Size() const
+    {
+        return entries.size();
+    }
+#pragma endregion
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef SCENECACHE_H
+#define SCENECACHE_H
+
+#include "Scene.h"
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace parseShape
+{
+    // En : Keeps the scenes of recently opened files uploaded, so switching back to one of them costs nothing.
+    // When the scenes hold more GPU memory than the budget, the least recently used ones are deleted.
+    // The scene returned last is never deleted, even if it alone is over the budget.
+    // Tr : Son açılan dosyaların sahnelerini yüklü tutar, böylece onlardan birine geri dönmenin bir maliyeti olmaz.
+    // Sahneler bütçeden fazla GPU belleği tuttuğunda en uzun süredir kullanılmayanlar silinir.
+    // Son döndürülen sahne, tek başına bütçeyi aşsa bile asla silinmez.
+    class SceneCache
+    {
+    private:
+        // En : `objects` and `shaders` are what the parser allocated for the scene, they are deleted with it.
+        // Tr : `objects` ve `shaders` ayrıştırıcının sahne için ayırdıklarıdır, sahneyle birlikte silinirler.
+        struct Entry
+        {
+            std::string path;
+            Scene *scene;
+            size_t memory;
+            uint64_t lastUse;
+            std::vector<Object *> objects;
+            std::vector<Shader *> shaders;
+        };
+        std::vector<Entry> entries;
+        size_t budget;
+        uint64_t useCount = 0;
+
+        void Own(Entry &entry);
+        void Release(Entry &entry);
+        void Trim();
+
+    public:
+        SceneCache(size_t budget = 256 * 1024 * 1024);
+        SceneCache(const SceneCache &) = delete;
+        SceneCache &operator=(const SceneCache &) = delete;
+        // En : Deletes every cached scene with its objects, camera and shaders.
+        // Tr : Önbellekteki her sahneyi nesneleri, kamerası ve shader'larıyla birlikte siler.
+        ~SceneCache();
+
+        // En : Returns the scene of the file, it is parsed and uploaded only if it is not cached.
+        // Returns null if the file could not be parsed. The scene is owned by the cache.
+        // Tr : Dosyanın sahnesini döndürür, yalnızca önbellekte değilse ayrıştırılır ve yüklenir.
+        // Dosya ayrıştırılamadıysa null döndürür. Sahnenin sahibi önbellektir.
+        Scene *Get(const std::string &path);
+        bool Contains(const std::string &path) const;
+        // En : Deletes the scene of the file and everything parsed with it if it is cached.
+        // Tr : Önbellekteyse dosyanın sahnesini ve onunla ayrıştırılan her şeyi siler.
+        void Evict(const std::string &path);
+        void Clear();
+
+        // En : Sets the GPU memory budget in bytes, scenes over it are deleted right away.
+        // Tr : GPU bellek bütçesini bayt olarak ayarlar, onu aşan sahneler hemen silinir.
+        void SetBudget(size_t budget);
+        size_t GetBudget() const;
+        // En : Returns the GPU memory of the cached scenes as of their last Update.
+        // Tr : Önbellekteki sahnelerin son Update'lerindeki GPU belleğini döndürür.
+        size_t GetMemory() const;
+        size_t Size() const;
+    };
+}
+#endif
\ No newline at end of file
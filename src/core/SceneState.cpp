@@ -0,0 +1,155 @@
+#ifndef SCENESTATE_CPP
+#define SCENESTATE_CPP
+
+#include "SceneState.h"
+
+#include <chrono>
+#include <algorithm>
+#include <iterator>
+
+namespace parseShape
+{
+    namespace
+    {
+        const unsigned int indexMask = 3, freshBit = 4;
+    }
+
+    bool ObjectState::operator==(const ObjectState &other) const
+    {
+        return position == other.position && scale == other.scale && rotation == other.rotation;
+    }
+    bool ObjectState::operator!=(const ObjectState &other) const
+    {
+        return !(*this == other);
+    }
+
+#pragma region Constructors and Destructors
+    SceneSimulation::SceneSimulation(Scene *scene) : scene(scene), middle(1), hasEdits(false), running(false)
+    {
+        for (auto object : scene->GetObjects())
+        {
+            ObjectState objectState;
+            objectState.position = object->GetPosition();
+            objectState.rotation = object->GetRotation();
+            objectState.scale = object->GetScale();
+            state.objects.push_back(objectState);
+        }
+        for (auto &snapshot : snapshots)
+            snapshot = state;
+        applied = state.objects;
+    }
+    SceneSimulation::~SceneSimulation()
+    {
+        Stop();
+    }
+#pragma endregion
+#pragma region Simulation thread
+    void SceneSimulation::Start(std::function<void(SceneSnapshot &state, float delta)> step, float rate)
+    {
+        Stop();
+        running = true;
+        thread = std::thread([this, step, rate]()
+                             {
+                                 using Clock = std::chrono::steady_clock;
+                                 const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+                                 Clock::time_point last = Clock::now(), next = last;
+                                 while (running.load(std::memory_order_relaxed))
+                                 {
+                                     Clock::time_point now = Clock::now();
+                                     float delta = std::chrono::duration<float>(now - last).count();
+                                     last = now;
+                                     step(state, delta);
+                                     state.time += delta;
+                                     Publish();
+                                     // En : A late step moves the schedule instead of running the missed steps back to back.
+                                     // Tr : Geciken bir adım kaçırılan adımları art arda çalıştırmak yerine zamanlamayı kaydırır.
+                                     next = std::max(next + period, now);
+                                     std::this_thread::sleep_until(next);
+                                 } });
+    }
+    void SceneSimulation::Stop()
+    {
+        running = false;
+        if (thread.joinable())
+            thread.join();
+    }
+    bool SceneSimulation::IsRunning() const
+    {
+        return running;
+    }
+    void SceneSimulation::Edit(std::function<void(Scene &)> edit)
+    {
+        stepEdits.push_back(std::move(edit));
+    }
+    // En : Copies the state into the back snapshot and swaps it with the middle one, the edits of the step are queued first
+    // so they are visible to the render thread once the snapshot is.
+    // Tr : Durumu arka anlık görüntüye kopyalar ve ortadaki ile değiştirir, adımın düzenlemeleri önce kuyruğa alınır
+    // böylece anlık görüntü görünür olduğunda render thread'ine de görünürler.
+    void SceneSimulation::Publish()
+    {
+        state.step++;
+        SceneSnapshot &snapshot = snapshots[back];
+        snapshot.objects.assign(state.objects.begin(), state.objects.end());
+        snapshot.step = state.step;
+        snapshot.time = state.time;
+        if (!stepEdits.empty())
+        {
+            std::lock_guard<std::mutex> lock(editMutex);
+            std::move(stepEdits.begin(), stepEdits.end(), std::back_inserter(queuedEdits));
+            stepEdits.clear();
+            hasEdits.store(true, std::memory_order_release);
+        }
+        back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+#pragma endregion
+#pragma region Render thread
+    bool SceneSimulation::Sync()
+    {
+        bool fresh = middle.load(std::memory_order_relaxed) & freshBit;
+        if (fresh)
+            front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        // En : The lock is only taken when a step queued edits.
+        // Tr : Kilit yalnızca bir adım düzenleme kuyruğa aldığında alınır.
+        if (hasEdits.load(std::memory_order_acquire))
+        {
+            {
+                std::lock_guard<std::mutex> lock(editMutex);
+                runEdits.swap(queuedEdits);
+                hasEdits.store(false, std::memory_order_relaxed);
+            }
+            for (auto &edit : runEdits)
+                edit(*scene);
+            runEdits.clear();
+        }
+        if (!fresh)
+            return false;
+
+        const std::vector<ObjectState> &objects = snapshots[front].objects;
+        std::vector<Object *> sceneObjects = scene->GetObjects();
+        size_t count = std::min(objects.size(), sceneObjects.size());
+        applied.resize(objects.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            // En : Values the simulation did not change are skipped, so changes made on the render thread are kept.
+            // Tr : Simülasyonun değiştirmediği değerler atlanır, böylece render thread'inde yapılan değişiklikler korunur.
+            const ObjectState &objectState = objects[i];
+            if (objectState == applied[i])
+                continue;
+            Object *object = sceneObjects[i];
+            if (objectState.position != applied[i].position)
+                object->SetPosition(objectState.position);
+            if (objectState.rotation != applied[i].rotation)
+                object->SetRotation(objectState.rotation);
+            if (objectState.scale != applied[i].scale)
+                object->SetScale(objectState.scale);
+            applied[i] = objectState;
+        }
+        return true;
+    }
+    const SceneSnapshot &SceneSimulation::GetFront() const
+    {
+        return snapshots[front];
+    }
+#pragma endregion
+}
+#endif
\ No newline at end of file
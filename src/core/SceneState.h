@@ -0,0 +1,103 @@
+#ifndef SCENESTATE_H
+#define SCENESTATE_H
+
+#include "Scene.h"
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <cstdint>
+#include <functional>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace parseShape
+{
+    // En : Local transform of one object in a snapshot.
+    // Tr : Bir anlık görüntüdeki bir nesnenin yerel dönüşümü.
+    struct ObjectState
+    {
+        glm::vec3 position = glm::vec3(0.0f), scale = glm::vec3(1.0f);
+        glm::quat rotation = glm::quat(1, 0, 0, 0);
+
+        bool operator==(const ObjectState &other) const;
+        bool operator!=(const ObjectState &other) const;
+    };
+
+    // En : State of the scene written by the simulation, `objects` is in the order of Scene::GetObjects.
+    // Tr : Simülasyonun yazdığı sahne durumu, `objects` Scene::GetObjects sırasındadır.
+    struct SceneSnapshot
+    {
+        std::vector<ObjectState> objects;
+        uint64_t step = 0;
+        double time = 0.0;
+    };
+
+    // En : Runs scene logic on its own thread while the render thread keeps drawing.
+    // The simulation only writes its own copy of the object transforms, every step is published into a triple buffer
+    // and the render thread takes the newest complete snapshot with Sync. Publishing and taking a snapshot is a single
+    // atomic exchange, neither side ever waits for the other. Changes that can not be expressed as transforms,
+    // like adding objects, are queued with Edit and run on the render thread before the snapshot they were made with.
+    // Tr : Render thread'i çizmeye devam ederken sahne mantığını kendi thread'inde çalıştırır.
+    // Simülasyon yalnızca nesne dönüşümlerinin kendi kopyasını yazar, her adım üçlü bir buffer'a yayınlanır ve
+    // render thread'i en yeni tam anlık görüntüyü Sync ile alır. Yayınlamak ve bir anlık görüntü almak tek bir atomik
+    // değiş tokuştur, iki taraf da diğerini asla beklemez. Nesne eklemek gibi dönüşüm olarak ifade edilemeyen
+    // değişiklikler Edit ile kuyruğa alınır ve yapıldıkları anlık görüntüden önce render thread'inde çalıştırılır.
+    class SceneSimulation
+    {
+    private:
+        Scene *scene;
+        SceneSnapshot snapshots[3];
+        // En : The snapshot between the threads, its index with `freshBit` set while the render thread has not taken it.
+        // `back` is only used by the simulation thread and `front` only by the render thread.
+        // Tr : Thread'ler arasındaki anlık görüntü, render thread'i onu almadığı sürece indisi `freshBit` ayarlı tutulur.
+        // `back` yalnızca simülasyon thread'i, `front` yalnızca render thread'i tarafından kullanılır.
+        std::atomic<unsigned int> middle;
+        unsigned int back = 0, front = 2;
+        // En : The simulation's own state, copied into the back snapshot on every step.
+        // Tr : Simülasyonun kendi durumu, her adımda arka anlık görüntüye kopyalanır.
+        SceneSnapshot state;
+        // En : The last snapshot values written into the objects, only the values the simulation changed since are written.
+        // Tr : Nesnelere yazılan son anlık görüntü değerleri, yalnızca simülasyonun o zamandan beri değiştirdiği değerler yazılır.
+        std::vector<ObjectState> applied;
+
+        std::vector<std::function<void(Scene &)>> stepEdits, queuedEdits, runEdits;
+        std::mutex editMutex;
+        std::atomic<bool> hasEdits;
+
+        std::thread thread;
+        std::atomic<bool> running;
+
+        void Publish();
+
+    public:
+        // En : Reads the current transforms of the objects of the scene as the first state.
+        // Tr : Sahnenin nesnelerinin güncel dönüşümlerini ilk durum olarak okur.
+        SceneSimulation(Scene *scene);
+        SceneSimulation(const SceneSimulation &) = delete;
+        SceneSimulation &operator=(const SceneSimulation &) = delete;
+        ~SceneSimulation();
+
+        // En : Starts calling `step` on the simulation thread `rate` times per second, `delta` is the time since the last step.
+        // Tr : Simülasyon thread'inde `step`'i saniyede `rate` kez çağırmaya başlar, `delta` son adımdan beri geçen süredir.
+        void Start(std::function<void(SceneSnapshot &state, float delta)> step, float rate = 60.0f);
+        // En : Stops the thread after its current step.
+        // Tr : Thread'i mevcut adımından sonra durdurur.
+        void Stop();
+        bool IsRunning() const;
+        // En : Queues a change of the scene, it may only be called from the step function.
+        // Tr : Sahnenin bir değişikliğini kuyruğa alır, yalnızca adım fonksiyonundan çağrılabilir.
+        void Edit(std::function<void(Scene &)> edit);
+
+        // En : Runs the queued edits and writes the transforms of the newest snapshot into the objects, called on the render thread
+        // before Scene::Update. Returns false if no new snapshot was published since the last call.
+        // Tr : Kuyruktaki düzenlemeleri çalıştırır ve en yeni anlık görüntünün dönüşümlerini nesnelere yazar, render thread'inde
+        // Scene::Update'ten önce çağrılır. Son çağrıdan beri yeni bir anlık görüntü yayınlanmadıysa false döndürür.
+        bool Sync();
+        // En : Returns the snapshot taken by the last Sync.
+        // Tr : Son Sync'in aldığı anlık görüntüyü döndürür.
+        const SceneSnapshot &GetFront() const;
+    };
+}
+#endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
 
 namespace parseShape
 {
@@ -81,7 +82,8 @@ namespace parseShape
                     }
                 }
 
-                std::string name = line.substr(line.find(type) + typeName.length() + 1, line.find(";") - line.find(type) - typeName.length() - 1);
+                int start = line.find(typeName) + typeName.length() + 1, end = line.find(";");
+                std::string name = line.substr(start, end - start);
                 uniforms.insert({name, type});
             }
             else if (line.find("in ") != std::string::npos &&
@@ -124,6 +126,7 @@ namespace parseShape
                             attributeSize += 16;
                             break;
                         case SAMPLER2D:
+                        case SAMPLERBUFFER:
                             attributeSize += 1;
                             break;
                         }
@@ -236,11 +239,28 @@ namespace parseShape
         }
     }
 
-    // En: Activates the shader
-    // Tr: Shader'ı aktif hale getirir
-    void Shader::Activate()
+    // En: Activates the shader and sets the vertex layout of the bound vertex array.
+    // `format` is the packed layout of the vertex buffer, the float layout of the shader is used if it is null.
+    // The vertices start `bufferOffset` bytes into the buffer.
+    // Tr: Shader'ı aktif hale getirir ve bağlı vertex array'in vertex düzenini ayarlar.
+    // `format` vertex buffer'ın paketlenmiş düzenidir, null ise shader'ın float düzeni kullanılır.
+    // Vertex'ler buffer'ın `bufferOffset` bayt içinden başlar.
+    void Shader::Activate(const VertexFormat *format, size_t bufferOffset)
     {
         glUseProgram(program);
+        if (format)
+        {
+            for (const PackedAttribute &attribute : format->attributes)
+            {
+                GLenum type = GetGLType(attribute.encoding);
+                // En: 10_10_10_2 attributes must always be read with four components.
+                // Tr: 10_10_10_2 attribute'lar her zaman dört bileşenle okunmalıdır.
+                int size = type == GL_INT_2_10_10_10_REV ? 4 : std::min(attribute.components, 4);
+                glEnableVertexAttribArray(attribute.location);
+                glVertexAttribPointer(attribute.location, size, type, type == GL_FLOAT ? GL_FALSE : GL_TRUE, format->stride, (void *)(bufferOffset + attribute.offset));
+            }
+            return;
+        }
         unsigned int offset = 0;
         for (int location : attributes)
         {
@@ -272,11 +292,12 @@ namespace parseShape
                 size = 16;
                 break;
             case SAMPLER2D:
+            case SAMPLERBUFFER:
                 size = 1;
                 break;
             }
             glEnableVertexAttribArray(location);
-            glVertexAttribPointer(location, size, GL_FLOAT, GL_FALSE, attributeSize * sizeof(float), (void *)(offset * sizeof(float)));
+            glVertexAttribPointer(location, size, GL_FLOAT, GL_FALSE, attributeSize * sizeof(float), (void *)(bufferOffset + offset * sizeof(float)));
             attributeOffsets[attributeNames[location]] = offset;
             offset += size;
         }
@@ -449,6 +470,14 @@ namespace parseShape
         return value;
     }
 
+    // En: Returns the location the linker gave to an attribute, -1 if the shader has no such active attribute.
+    // Attributes without a layout qualifier are not part of the vertex layout and can only be found this way.
+    // Tr: Bağlayıcının bir attribute'a verdiği konumu döndürür, shader'da böyle aktif bir attribute yoksa -1.
+    // Layout niteleyicisi olmayan attribute'lar vertex düzeninin parçası değildir ve yalnızca bu yolla bulunabilir.
+    GLint Shader::GetAttributeLocation(const char *name) const
+    {
+        return glGetAttribLocation(program, name);
+    }
     unsigned int Shader::GetAttributeSize() const
     {
         return attributeSize;
@@ -6,6 +6,7 @@
 #include <map>
 
 #include "Attribute.h"
+#include "VertexFormat.h"
 
 namespace parseShape
 {
@@ -27,7 +28,7 @@ namespace parseShape
     public:
         Shader(const char *vertexPath, const char *fragmentPath);
         ~Shader();
-        void Activate();
+        void Activate(const VertexFormat *format = nullptr, size_t bufferOffset = 0);
         void Use();
 
         void Set(const char *name, float value);
@@ -68,6 +69,7 @@ namespace parseShape
         AttributeTypeName GetAttributeTypes() const;
         AttributeOffset GetAttributeOffsets() const;
         std::string GetAttributeName(int location) const;
+        GLint GetAttributeLocation(const char *name) const;
     };
 }
 #endif
\ No newline at end of file
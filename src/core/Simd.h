@@ -0,0 +1,19 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+// En : Detects the SIMD instruction sets the hot loops can use, every user keeps a scalar fallback.
+// Tr : Yoğun döngülerin kullanabileceği SIMD komut setlerini algılar, her kullanıcı skaler bir yedek tutar.
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARSESHAPE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// En : GCC and Clang define __F16C__ only with -mf16c, -mavx2 does not imply it. MSVC has no such macro, /arch:AVX2 implies F16C.
+// Tr : GCC ve Clang __F16C__'yi yalnızca -mf16c ile tanımlar, -mavx2 onu içermez. MSVC'de böyle bir makro yoktur, /arch:AVX2 F16C'yi içerir.
+#if defined(PARSESHAPE_SSE2) && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#define PARSESHAPE_F16C 1
+#include <immintrin.h>
+#endif
+
+#endif
\ No newline at end of file
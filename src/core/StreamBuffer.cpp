@@ -0,0 +1,94 @@
+#ifndef STREAM_BUFFER_CPP
+#define STREAM_BUFFER_CPP
+
+#include "StreamBuffer.h"
+
+namespace parseShape
+{
+    StreamBuffer::StreamBuffer(int segmentCount)
+    {
+        fences.resize(segmentCount > 0 ? segmentCount : 1, nullptr);
+        glGenBuffers(1, &buffer);
+    }
+    StreamBuffer::~StreamBuffer()
+    {
+        DeleteFences();
+        glDeleteBuffers(1, &buffer);
+    }
+    void StreamBuffer::DeleteFences()
+    {
+        for (auto &fence : fences)
+        {
+            if (fence)
+                glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    void StreamBuffer::Resize(size_t segmentSize)
+    {
+        DeleteFences();
+        this->segmentSize = segmentSize;
+        segment = 0;
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glBufferData(GL_ARRAY_BUFFER, segmentSize * fences.size(), nullptr, GL_STREAM_DRAW);
+    }
+    void *StreamBuffer::Map()
+    {
+        if (!segmentSize)
+            return nullptr;
+        segment = (segment + 1) % fences.size();
+        GLsync &fence = fences[segment];
+        if (fence)
+        {
+            // En : The first wait flushes the commands, otherwise the fence may never be reached.
+            // Tr : İlk bekleme komutları gönderir, aksi halde fence'e hiç ulaşılmayabilir.
+            GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+            while (true)
+            {
+                GLenum result = glClientWaitSync(fence, flags, 1000000000);
+                if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+                    break;
+                flags = 0;
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        return glMapBufferRange(GL_ARRAY_BUFFER, GetOffset(), segmentSize, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    }
+    void StreamBuffer::Unmap()
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+    void StreamBuffer::Fence()
+    {
+        GLsync &fence = fences[segment];
+        if (fence)
+            glDeleteSync(fence);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    GLuint StreamBuffer::GetBuffer() const
+    {
+        return buffer;
+    }
+    size_t StreamBuffer::GetSegmentSize() const
+    {
+        return segmentSize;
+    }
+    int StreamBuffer::GetSegment() const
+    {
+        return segment;
+    }
+    int StreamBuffer::GetSegmentCount() const
+    {
+        return fences.size();
+    }
+    size_t StreamBuffer::GetOffset() const
+    {
+        return segmentSize * segment;
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#include <vector>
+#include <cstddef>
+#include <GL/glew.h>
+
+namespace parseShape
+{
+    // En : A vertex buffer split into segments that are written in turn, for geometry that changes every frame.
+    // Each segment is mapped unsynchronized and guarded with a fence, so the CPU never waits for the driver
+    // unless it gets more than `segmentCount` frames ahead of the GPU.
+    // Tr : Her karede değişen geometri için sırayla yazılan bölümlere ayrılmış bir vertex buffer.
+    // Her bölüm senkronizasyonsuz eşlenir ve bir fence ile korunur, böylece CPU GPU'nun
+    // `segmentCount` kareden fazla önüne geçmedikçe sürücüyü asla beklemez.
+    class StreamBuffer
+    {
+    private:
+        GLuint buffer = 0;
+        size_t segmentSize = 0;
+        int segment = 0;
+        std::vector<GLsync> fences;
+
+        void DeleteFences();
+
+    public:
+        StreamBuffer(int segmentCount = 3);
+        ~StreamBuffer();
+        StreamBuffer(const StreamBuffer &) = delete;
+        StreamBuffer &operator=(const StreamBuffer &) = delete;
+
+        // En : Reallocates the buffer so every segment holds `segmentSize` bytes, the contents are lost.
+        // Tr : Buffer'ı her bölüm `segmentSize` bayt tutacak şekilde yeniden ayırır, içerik kaybolur.
+        void Resize(size_t segmentSize);
+        // En : Moves to the next segment, waits until the GPU finished reading it and maps it for writing.
+        // Leaves the buffer bound to GL_ARRAY_BUFFER. Returns null if the buffer is empty or mapping failed.
+        // Tr : Bir sonraki bölüme geçer, GPU'nun onu okumayı bitirmesini bekler ve yazmak için eşler.
+        // Buffer'ı GL_ARRAY_BUFFER'a bağlı bırakır. Buffer boşsa ya da eşleme başarısız olduysa null döndürür.
+        void *Map();
+        void Unmap();
+        // En : Marks the end of the draws that read the current segment.
+        // Tr : Geçerli bölümü okuyan çizimlerin sonunu işaretler.
+        void Fence();
+
+        GLuint GetBuffer() const;
+        size_t GetSegmentSize() const;
+        int GetSegment() const;
+        int GetSegmentCount() const;
+        // En : Returns the byte offset of the current segment.
+        // Tr : Geçerli bölümün bayt ofsetini döndürür.
+        size_t GetOffset() const;
+    };
+}
+#endif
\ No newline at end of file
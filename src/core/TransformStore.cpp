@@ -0,0 +1,369 @@
+#ifndef TRANSFORMSTORE_CPP
+#define TRANSFORMSTORE_CPP
+
+#include "TransformStore.h"
+#include "Object.h"
+#include "Parallel.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <numeric>
+
+namespace parseShape
+{
+    namespace
+    {
+        const unsigned char localStale = 1, pivotStale = 2;
+        const size_t localBatch = 256;
+    }
+
+    bool TransformHandle::IsValid() const
+    {
+        return index != UINT32_MAX;
+    }
+    bool TransformHandle::operator==(const TransformHandle &other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+    bool TransformHandle::operator!=(const TransformHandle &other) const
+    {
+        return !(*this == other);
+    }
+
+    glm::mat4 ComposeTransform(glm::vec3 position, glm::quat rotation, glm::vec3 scale, glm::vec3 pivot)
+    {
+        return glm::translate(glm::mat4(1.0f), position + pivot) * glm::mat4_cast(rotation) *
+               glm::scale(glm::mat4(1.0f), scale) * glm::translate(glm::mat4(1.0f), -pivot);
+    }
+
+#pragma region Constructors and Destructors
+    TransformStore::~TransformStore()
+    {
+        for (size_t i = 0; i < owners.size(); i++)
+        {
+            Object *owner = owners[i];
+            if (!owner)
+                continue;
+            owner->position = positions[i];
+            owner->rotation = rotations[i];
+            owner->scale = scales[i];
+            owner->store = nullptr;
+            owner->handle = TransformHandle();
+            owner->worldDirty = true;
+        }
+    }
+#pragma endregion
+#pragma region Entries
+    TransformHandle TransformStore::Create(glm::vec3 position, glm::quat rotation, glm::vec3 scale, Object *owner)
+    {
+        TransformHandle handle;
+        if (freeSlots.empty())
+        {
+            handle.index = slots.size();
+            slots.push_back(0);
+            generations.push_back(0);
+        }
+        else
+        {
+            handle.index = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        handle.generation = generations[handle.index];
+        slots[handle.index] = positions.size();
+        handles.push_back(handle.index);
+        positions.push_back(position);
+        rotations.push_back(rotation);
+        scales.push_back(scale);
+        pivots.push_back(glm::vec3(0.0f));
+        locals.push_back(glm::mat4(1.0f));
+        worlds.push_back(glm::mat4(1.0f));
+        parents.push_back(-1);
+        versions.push_back(0);
+        parentVersions.push_back(0);
+        flags.push_back(owner ? localStale | pivotStale : localStale);
+        owners.push_back(owner);
+        return handle;
+    }
+    // En : Copies the entry at `from` over the entry at `to` and points its slot and its children at the new index.
+    // Tr : `from`'daki elemanı `to`'daki elemanın üzerine kopyalar ve yuvasını ve çocuklarını yeni indise yönlendirir.
+    void TransformStore::Move(size_t from, size_t to)
+    {
+        positions[to] = positions[from];
+        rotations[to] = rotations[from];
+        scales[to] = scales[from];
+        pivots[to] = pivots[from];
+        locals[to] = locals[from];
+        worlds[to] = worlds[from];
+        parents[to] = parents[from];
+        versions[to] = versions[from];
+        parentVersions[to] = parentVersions[from];
+        flags[to] = flags[from];
+        owners[to] = owners[from];
+        handles[to] = handles[from];
+        slots[handles[to]] = to;
+        orderDirty |= parents[to] > (int)to;
+        for (size_t i = 0; i < parents.size(); i++)
+        {
+            if (parents[i] != (int)from)
+                continue;
+            parents[i] = to;
+            orderDirty |= i < to;
+        }
+    }
+    void TransformStore::Destroy(TransformHandle handle)
+    {
+        if (!IsValid(handle))
+            return;
+        size_t index = slots[handle.index], last = positions.size() - 1;
+        for (size_t i = 0; i < parents.size(); i++)
+        {
+            if (parents[i] != (int)index)
+                continue;
+            parents[i] = -1;
+            flags[i] |= localStale;
+        }
+        if (index != last)
+            Move(last, index);
+        positions.pop_back();
+        rotations.pop_back();
+        scales.pop_back();
+        pivots.pop_back();
+        locals.pop_back();
+        worlds.pop_back();
+        parents.pop_back();
+        versions.pop_back();
+        parentVersions.pop_back();
+        flags.pop_back();
+        owners.pop_back();
+        handles.pop_back();
+        generations[handle.index]++;
+        slots[handle.index] = UINT32_MAX;
+        freeSlots.push_back(handle.index);
+    }
+    bool TransformStore::IsValid(TransformHandle handle) const
+    {
+        return handle.index < slots.size() && generations[handle.index] == handle.generation && slots[handle.index] != UINT32_MAX;
+    }
+    size_t TransformStore::GetIndex(TransformHandle handle) const
+    {
+        return slots[handle.index];
+    }
+    TransformHandle TransformStore::GetHandle(size_t index) const
+    {
+        TransformHandle handle;
+        handle.index = handles[index];
+        handle.generation = generations[handle.index];
+        return handle;
+    }
+    size_t TransformStore::Size() const
+    {
+        return positions.size();
+    }
+#pragma endregion
+#pragma region Hierarchy
+    void TransformStore::SetParent(TransformHandle handle, TransformHandle parent)
+    {
+        size_t index = GetIndex(handle);
+        int parentIndex = IsValid(parent) ? (int)GetIndex(parent) : -1;
+        for (int ancestor = parentIndex; ancestor >= 0; ancestor = parents[ancestor])
+            if (ancestor == (int)index)
+                return;
+        parents[index] = parentIndex;
+        flags[index] |= localStale;
+        orderDirty |= parentIndex > (int)index;
+    }
+    TransformHandle TransformStore::GetParent(TransformHandle handle) const
+    {
+        int parent = parents[GetIndex(handle)];
+        return parent >= 0 ? GetHandle(parent) : TransformHandle();
+    }
+    // En : Orders the entries by their depth in the hierarchy, so every parent comes before its children.
+    // Tr : Elemanları hiyerarşideki derinliklerine göre sıralar, böylece her ebeveyn çocuklarından önce gelir.
+    void TransformStore::Sort()
+    {
+        size_t count = positions.size();
+        std::vector<int> depths(count, -1);
+        for (size_t i = 0; i < count; i++)
+        {
+            int depth = 0;
+            for (int ancestor = parents[i]; ancestor >= 0; ancestor = parents[ancestor])
+            {
+                if (depths[ancestor] >= 0)
+                {
+                    depth += depths[ancestor] + 1;
+                    break;
+                }
+                depth++;
+            }
+            depths[i] = depth;
+        }
+        std::vector<size_t> order(count), newIndices(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                         { return depths[a] < depths[b]; });
+        for (size_t i = 0; i < count; i++)
+            newIndices[order[i]] = i;
+
+        auto permute = [&](auto &values)
+        {
+            auto sorted = values;
+            for (size_t i = 0; i < count; i++)
+                sorted[i] = values[order[i]];
+            values.swap(sorted);
+        };
+        permute(positions);
+        permute(rotations);
+        permute(scales);
+        permute(pivots);
+        permute(locals);
+        permute(worlds);
+        permute(parents);
+        permute(versions);
+        permute(parentVersions);
+        permute(flags);
+        permute(owners);
+        permute(handles);
+        for (size_t i = 0; i < count; i++)
+        {
+            if (parents[i] >= 0)
+                parents[i] = newIndices[parents[i]];
+            slots[handles[i]] = i;
+        }
+        orderDirty = false;
+    }
+#pragma endregion
+#pragma region Transforms
+    void TransformStore::SetPosition(TransformHandle handle, glm::vec3 position)
+    {
+        size_t index = GetIndex(handle);
+        positions[index] = position;
+        flags[index] |= localStale;
+    }
+    void TransformStore::SetRotation(TransformHandle handle, glm::quat rotation)
+    {
+        size_t index = GetIndex(handle);
+        rotations[index] = rotation;
+        flags[index] |= localStale;
+    }
+    void TransformStore::SetScale(TransformHandle handle, glm::vec3 scale)
+    {
+        size_t index = GetIndex(handle);
+        scales[index] = scale;
+        flags[index] |= localStale;
+    }
+    void TransformStore::SetPivot(TransformHandle handle, glm::vec3 pivot)
+    {
+        size_t index = GetIndex(handle);
+        pivots[index] = pivot;
+        flags[index] |= localStale;
+    }
+    glm::vec3 TransformStore::GetPosition(TransformHandle handle) const
+    {
+        return positions[GetIndex(handle)];
+    }
+    glm::quat TransformStore::GetRotation(TransformHandle handle) const
+    {
+        return rotations[GetIndex(handle)];
+    }
+    glm::vec3 TransformStore::GetScale(TransformHandle handle) const
+    {
+        return scales[GetIndex(handle)];
+    }
+    void TransformStore::Invalidate(TransformHandle handle)
+    {
+        flags[GetIndex(handle)] |= localStale | pivotStale;
+    }
+    void TransformStore::Invalidate(size_t begin, size_t end)
+    {
+        end = std::min(end, flags.size());
+        for (size_t i = begin; i < end; i++)
+            flags[i] |= localStale | pivotStale;
+    }
+    void TransformStore::UpdateLocal(size_t index)
+    {
+        if ((flags[index] & pivotStale) && owners[index])
+            pivots[index] = owners[index]->GetPivot();
+        locals[index] = ComposeTransform(positions[index], rotations[index], scales[index], pivots[index]);
+    }
+    // En : Brings the world matrix of the entry up to date, nothing is written if the path to the root is not stale.
+    // Tr : Elemanın dünya matrisini günceller, köke giden yol eskimiş değilse hiçbir şey yazılmaz.
+    void TransformStore::Resolve(size_t index)
+    {
+        int parent = parents[index];
+        if (parent >= 0)
+            Resolve(parent);
+        bool stale = flags[index] != 0;
+        if (stale)
+        {
+            UpdateLocal(index);
+            flags[index] = 0;
+        }
+        if (parent >= 0 && parentVersions[index] != versions[parent])
+            stale = true;
+        if (!stale)
+            return;
+        worlds[index] = parent >= 0 ? worlds[parent] * locals[index] : locals[index];
+        parentVersions[index] = parent >= 0 ? versions[parent] : 0;
+        versions[index]++;
+    }
+    const glm::mat4 &TransformStore::GetLocalMatrix(TransformHandle handle)
+    {
+        size_t index = GetIndex(handle);
+        Resolve(index);
+        return locals[index];
+    }
+    const glm::mat4 &TransformStore::GetWorldMatrix(TransformHandle handle)
+    {
+        size_t index = GetIndex(handle);
+        Resolve(index);
+        return worlds[index];
+    }
+    // En : Local matrices only depend on their own entry, so they are written in parallel. World matrices are written in
+    // array order, where every parent is already up to date when its children are reached.
+    // Tr : Yerel matrisler yalnızca kendi elemanlarına bağlıdır, bu yüzden paralel yazılırlar. Dünya matrisleri dizi
+    // sırasında yazılır, burada çocuklarına ulaşıldığında her ebeveyn zaten günceldir.
+    void TransformStore::UpdateWorldMatrices()
+    {
+        if (orderDirty)
+            Sort();
+        ParallelFor(positions.size(), [this](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; i++)
+                            if (flags[i])
+                                UpdateLocal(i); }, localBatch);
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            int parent = parents[i];
+            if (!flags[i] && (parent < 0 || parentVersions[i] == versions[parent]))
+                continue;
+            worlds[i] = parent >= 0 ? worlds[parent] * locals[i] : locals[i];
+            parentVersions[i] = parent >= 0 ? versions[parent] : 0;
+            versions[i]++;
+            flags[i] = 0;
+        }
+    }
+#pragma endregion
+#pragma region Arrays
+    glm::vec3 *TransformStore::GetPositions()
+    {
+        return positions.data();
+    }
+    glm::quat *TransformStore::GetRotations()
+    {
+        return rotations.data();
+    }
+    glm::vec3 *TransformStore::GetScales()
+    {
+        return scales.data();
+    }
+    const int *TransformStore::GetParents() const
+    {
+        return parents.data();
+    }
+    const glm::mat4 *TransformStore::GetWorldMatrices() const
+    {
+        return worlds.data();
+    }
+#pragma endregion
+}
+#endif
\ No newline at end of file
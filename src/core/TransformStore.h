@@ -0,0 +1,127 @@
+#ifndef TRANSFORMSTORE_H
+#define TRANSFORMSTORE_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace parseShape
+{
+    class Object;
+
+    // En : Stable reference to an entry of a transform store, it stays valid while the entries around it are added and removed.
+    // A handle of a destroyed entry is detected by its generation.
+    // Tr : Bir dönüşüm deposunun elemanına kalıcı referans, etrafındaki elemanlar eklenip silinirken geçerli kalır.
+    // Silinmiş bir elemanın handle'ı kuşağından anlaşılır.
+    struct TransformHandle
+    {
+        uint32_t index = UINT32_MAX, generation = 0;
+
+        bool IsValid() const;
+        bool operator==(const TransformHandle &other) const;
+        bool operator!=(const TransformHandle &other) const;
+    };
+
+    // En : Returns the matrix that scales and rotates around `pivot` and then translates by `position`.
+    // Tr : `pivot` etrafında ölçekleyip döndüren ve ardından `position` kadar öteleyen matrisi döndürür.
+    glm::mat4 ComposeTransform(glm::vec3 position, glm::quat rotation, glm::vec3 scale, glm::vec3 pivot);
+
+    // En : Keeps the transforms of many objects in separate contiguous arrays, so systems that move, animate or cull objects
+    // walk them linearly instead of chasing object pointers. Entries are addressed by handles, the arrays stay packed
+    // when entries are removed and parents are kept in front of their children, so one pass updates every world matrix.
+    // Objects attached to a store become facades that read and write their entry.
+    // Tr : Birçok nesnenin dönüşümlerini ayrı bitişik dizilerde tutar, böylece nesneleri hareket ettiren, canlandıran ya da
+    // ayıklayan sistemler nesne işaretçileri izlemek yerine onları doğrusal dolaşır. Elemanlara handle'larla erişilir,
+    // elemanlar silindiğinde diziler sıkı kalır ve ebeveynler çocuklarının önünde tutulur, böylece tek geçiş her dünya
+    // matrisini günceller. Bir depoya bağlanan nesneler elemanlarını okuyup yazan cepheler olur.
+    class TransformStore
+    {
+    private:
+        std::vector<glm::vec3> positions, scales, pivots;
+        std::vector<glm::quat> rotations;
+        std::vector<glm::mat4> locals, worlds;
+        // En : Index of the parent in the arrays or -1, always smaller than the index of the child after an update.
+        // Tr : Ebeveynin dizilerdeki indisi ya da -1, bir güncellemeden sonra her zaman çocuğun indisinden küçüktür.
+        std::vector<int> parents;
+        // En : `versions` counts the world matrix changes of an entry, `parentVersions` is the version of the parent
+        // its world matrix was calculated with. `flags` marks stale local matrices and pivots.
+        // Tr : `versions` bir elemanın dünya matrisi değişikliklerini sayar, `parentVersions` dünya matrisinin hesaplandığı
+        // ebeveyn sürümüdür. `flags` eskimiş yerel matrisleri ve pivotları işaretler.
+        std::vector<uint32_t> versions, parentVersions;
+        std::vector<unsigned char> flags;
+        std::vector<Object *> owners;
+        // En : `handles` maps an array index to its slot, `slots` maps a slot to its array index.
+        // Tr : `handles` bir dizi indisini yuvasına, `slots` bir yuvayı dizi indisine eşler.
+        std::vector<uint32_t> handles, slots, generations, freeSlots;
+        bool orderDirty = false;
+
+        void UpdateLocal(size_t index);
+        void Resolve(size_t index);
+        void Move(size_t from, size_t to);
+        void Sort();
+
+    public:
+        TransformStore() = default;
+        TransformStore(const TransformStore &) = delete;
+        TransformStore &operator=(const TransformStore &) = delete;
+        // En : Objects still attached keep their last transform and become standalone again.
+        // Tr : Hâlâ bağlı nesneler son dönüşümlerini korur ve yeniden bağımsız olur.
+        ~TransformStore();
+
+        // En : Adds an entry, `owner` is asked for its pivot whenever the entry is invalidated.
+        // Tr : Bir eleman ekler, eleman geçersiz kılındığında `owner`'dan pivotu istenir.
+        TransformHandle Create(glm::vec3 position = glm::vec3(0.0f), glm::quat rotation = glm::quat(1, 0, 0, 0),
+                               glm::vec3 scale = glm::vec3(1.0f), Object *owner = nullptr);
+        // En : Removes the entry, its children become roots.
+        // Tr : Elemanı siler, çocukları kök olur.
+        void Destroy(TransformHandle handle);
+        bool IsValid(TransformHandle handle) const;
+        // En : Returns the current array index of the entry, it changes when entries are removed or reordered.
+        // Tr : Elemanın güncel dizi indisini döndürür, elemanlar silindiğinde ya da yeniden sıralandığında değişir.
+        size_t GetIndex(TransformHandle handle) const;
+        TransformHandle GetHandle(size_t index) const;
+        size_t Size() const;
+
+        // En : Attaches the entry to `parent`, an invalid parent detaches it. Parents that would create a cycle are ignored.
+        // Tr : Elemanı `parent`'a bağlar, geçersiz bir ebeveyn onu ayırır. Döngü oluşturacak ebeveynler yok sayılır.
+        void SetParent(TransformHandle handle, TransformHandle parent);
+        TransformHandle GetParent(TransformHandle handle) const;
+
+        void SetPosition(TransformHandle handle, glm::vec3 position);
+        void SetRotation(TransformHandle handle, glm::quat rotation);
+        void SetScale(TransformHandle handle, glm::vec3 scale);
+        void SetPivot(TransformHandle handle, glm::vec3 pivot);
+        glm::vec3 GetPosition(TransformHandle handle) const;
+        glm::quat GetRotation(TransformHandle handle) const;
+        glm::vec3 GetScale(TransformHandle handle) const;
+        // En : Marks the local matrix of the entry as stale, the pivot is read from the owner again.
+        // Tr : Elemanın yerel matrisini eskimiş olarak işaretler, pivot sahibinden yeniden okunur.
+        void Invalidate(TransformHandle handle);
+        // En : Marks the entries [begin, end) as stale after their arrays were written directly.
+        // Tr : Dizileri doğrudan yazıldıktan sonra [begin, end) elemanlarını eskimiş olarak işaretler.
+        void Invalidate(size_t begin, size_t end);
+
+        // En : Return the matrices of one entry, only the stale part of the path to the root is recalculated.
+        // Reading them from several threads is only safe once nothing on the path is stale.
+        // Tr : Bir elemanın matrislerini döndürür, köke giden yolun yalnızca eskimiş kısmı yeniden hesaplanır.
+        // Birden fazla thread'den okumak yalnızca yolda eskimiş bir şey yokken güvenlidir.
+        const glm::mat4 &GetLocalMatrix(TransformHandle handle);
+        const glm::mat4 &GetWorldMatrix(TransformHandle handle);
+        // En : Recalculates the stale local matrices in parallel and then every stale world matrix in one pass in array order.
+        // Tr : Eskimiş yerel matrisleri paralel, ardından eskimiş her dünya matrisini dizi sırasında tek geçişte yeniden hesaplar.
+        void UpdateWorldMatrices();
+
+        // En : Arrays for batch systems, entries written through them must be invalidated.
+        // Tr : Toplu sistemler için diziler, bunlar üzerinden yazılan elemanlar geçersiz kılınmalıdır.
+        glm::vec3 *GetPositions();
+        glm::quat *GetRotations();
+        glm::vec3 *GetScales();
+        const int *GetParents() const;
+        // En : World matrices as of the last UpdateWorldMatrices.
+        // Tr : Son UpdateWorldMatrices'teki dünya matrisleri.
+        const glm::mat4 *GetWorldMatrices() const;
+    };
+}
+#endif
\ No newline at end of file
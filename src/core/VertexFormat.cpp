@@ -0,0 +1,297 @@
+#ifndef VERTEX_FORMAT_CPP
+#define VERTEX_FORMAT_CPP
+
+#include "VertexFormat.h"
+#include "Shader.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace parseShape
+{
+    // En : Converts a float to a 16 bit float, rounding to nearest even.
+    // Tr : Bir float'u en yakın çifte yuvarlayarak 16 bit float'a dönüştürür.
+    static uint16_t FloatToHalf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        uint32_t sign = (bits >> 16) & 0x8000, exponent = (bits >> 23) & 0xFF, mantissa = bits & 0x7FFFFF;
+        if (exponent == 0xFF)
+            return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+        int halfExponent = (int)exponent - 127 + 15;
+        if (halfExponent >= 31)
+            return sign | 0x7C00;
+        if (halfExponent <= 0)
+        {
+            if (halfExponent < -10)
+                return sign;
+            mantissa |= 0x800000;
+            int shift = 14 - halfExponent;
+            uint32_t half = mantissa >> shift, rest = mantissa & ((1u << shift) - 1), middle = 1u << (shift - 1);
+            if (rest > middle || (rest == middle && (half & 1)))
+                half++;
+            return sign | half;
+        }
+        uint32_t half = sign | (halfExponent << 10) | (mantissa >> 13), rest = mantissa & 0x1FFF;
+        if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+            half++;
+        return half;
+    }
+
+    static int Round(float value)
+    {
+        return (int)std::lround(value);
+    }
+
+    // En : Encodes one attribute of every vertex, the loops are kept separate so each stays a tight kernel.
+    // Tr : Her vertex'in bir attribute'unu kodlar, her biri sıkı bir çekirdek olarak kalsın diye döngüler ayrı tutulur.
+    static void EncodeAttribute(const PackedAttribute &attribute, const VertexFormat &format, const QuantizationRange &range,
+                                const float *source, size_t vertexCount, unsigned char *destination)
+    {
+        const float *in = source + attribute.sourceOffset;
+        unsigned char *out = destination + attribute.offset;
+        const unsigned int sourceSize = format.sourceSize, stride = format.stride;
+        const int components = std::min(attribute.components, 4);
+        const bool wide = GetPackedSize(attribute.encoding, components) == 8;
+
+        glm::vec4 scale(1.0f), bias(0.0f);
+        if (attribute.isPosition)
+        {
+            // En : Stored values are (p - bias) / scale, the inverse of the shader's decode.
+            // Tr : Saklanan değerler (p - bias) / scale'dir, shader'daki çözmenin tersidir.
+            scale = glm::vec4(1.0f / range.scale.x, 1.0f / range.scale.y, 1.0f / range.scale.z, 1.0f);
+            bias = glm::vec4(range.bias, 0.0f);
+        }
+
+        switch (attribute.encoding)
+        {
+        case VertexEncoding::Float:
+        {
+            for (size_t i = 0; i < vertexCount; i++)
+                std::memcpy(out + i * stride, in + i * sourceSize, components * sizeof(float));
+            break;
+        }
+        case VertexEncoding::Half:
+        {
+#ifdef PARSESHAPE_F16C
+            const __m128 s = _mm_loadu_ps(&scale.x), b = _mm_loadu_ps(&bias.x);
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                const float *p = in + i * sourceSize;
+                __m128 v = _mm_set_ps(components > 3 ? p[3] : 0.0f, components > 2 ? p[2] : 0.0f, components > 1 ? p[1] : 0.0f, p[0]);
+                v = _mm_mul_ps(_mm_sub_ps(v, b), s);
+                __m128i q = _mm_cvtps_ph(v, 0);
+                if (wide)
+                    _mm_storel_epi64((__m128i *)(out + i * stride), q);
+                else
+                {
+                    int packed = _mm_cvtsi128_si32(q);
+                    std::memcpy(out + i * stride, &packed, sizeof(packed));
+                }
+            }
+#else
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                const float *p = in + i * sourceSize;
+                uint16_t packed[4] = {0, 0, 0, 0};
+                for (int k = 0; k < components; k++)
+                    packed[k] = FloatToHalf((p[k] - bias[k]) * scale[k]);
+                std::memcpy(out + i * stride, packed, wide ? 8 : 4);
+            }
+#endif
+            break;
+        }
+        case VertexEncoding::Snorm16:
+        {
+#ifdef PARSESHAPE_SSE2
+            const __m128 s = _mm_mul_ps(_mm_loadu_ps(&scale.x), _mm_set1_ps(32767.0f)), b = _mm_loadu_ps(&bias.x);
+            const __m128 low = _mm_set1_ps(-32767.0f), high = _mm_set1_ps(32767.0f);
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                const float *p = in + i * sourceSize;
+                __m128 v = _mm_set_ps(components > 3 ? p[3] : 0.0f, components > 2 ? p[2] : 0.0f, components > 1 ? p[1] : 0.0f, p[0]);
+                v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(v, b), s), low), high);
+                __m128i q = _mm_cvtps_epi32(v);
+                q = _mm_packs_epi32(q, q);
+                if (wide)
+                    _mm_storel_epi64((__m128i *)(out + i * stride), q);
+                else
+                {
+                    int packed = _mm_cvtsi128_si32(q);
+                    std::memcpy(out + i * stride, &packed, sizeof(packed));
+                }
+            }
+#else
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                const float *p = in + i * sourceSize;
+                int16_t packed[4] = {0, 0, 0, 0};
+                for (int k = 0; k < components; k++)
+                    packed[k] = (int16_t)Round(glm::clamp((p[k] - bias[k]) * scale[k], -1.0f, 1.0f) * 32767.0f);
+                std::memcpy(out + i * stride, packed, wide ? 8 : 4);
+            }
+#endif
+            break;
+        }
+        case VertexEncoding::Snorm10:
+        {
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                const float *p = in + i * sourceSize;
+                int q[4] = {0, 0, 0, 0};
+#ifdef PARSESHAPE_SSE2
+                __m128 v = _mm_set_ps(0.0f, components > 2 ? p[2] : 0.0f, components > 1 ? p[1] : 0.0f, p[0]);
+                v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+                _mm_storeu_si128((__m128i *)q, _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(511.0f))));
+#else
+                for (int k = 0; k < std::min(components, 3); k++)
+                    q[k] = Round(glm::clamp(p[k], -1.0f, 1.0f) * 511.0f);
+#endif
+                uint32_t packed = ((uint32_t)q[0] & 0x3FF) | (((uint32_t)q[1] & 0x3FF) << 10) | (((uint32_t)q[2] & 0x3FF) << 20);
+                std::memcpy(out + i * stride, &packed, sizeof(packed));
+            }
+            break;
+        }
+        case VertexEncoding::Unorm8:
+        {
+#ifdef PARSESHAPE_SSE2
+            const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), factor = _mm_set1_ps(255.0f);
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                const float *p = in + i * sourceSize;
+                __m128 v = _mm_set_ps(components > 3 ? p[3] : 1.0f, components > 2 ? p[2] : 0.0f, components > 1 ? p[1] : 0.0f, p[0]);
+                __m128i q = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(v, zero), one), factor));
+                q = _mm_packs_epi32(q, q);
+                q = _mm_packus_epi16(q, q);
+                int packed = _mm_cvtsi128_si32(q);
+                std::memcpy(out + i * stride, &packed, sizeof(packed));
+            }
+#else
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                const float *p = in + i * sourceSize;
+                uint8_t packed[4] = {0, 0, 0, 255};
+                for (int k = 0; k < components; k++)
+                    packed[k] = (uint8_t)Round(glm::clamp(p[k], 0.0f, 1.0f) * 255.0f);
+                std::memcpy(out + i * stride, packed, sizeof(packed));
+            }
+#endif
+            break;
+        }
+        }
+    }
+
+    // En : Builds a packed format from the attributes of the shader.
+    // `shader` is the shader whose attributes are packed.
+    // `positionEncoding` is the encoding of the position, Float disables position quantization.
+    // Tr : Shader'ın attribute'larından paketlenmiş bir format oluşturur.
+    // `shader` attribute'ları paketlenecek shader'dır.
+    // `positionEncoding` konumun kodlamasıdır, Float konum nicemlemesini kapatır.
+    VertexFormat CreateVertexFormat(Shader *shader, VertexEncoding positionEncoding)
+    {
+        VertexFormat format;
+        if (!shader)
+            return format;
+
+        AttributeOffset offsets = shader->GetAttributeOffsets();
+        AttributeTypeName types = shader->GetAttributeTypes();
+        AttributeLocation locations = shader->GetAttributeLocations();
+        std::vector<std::pair<unsigned int, std::string>> ordered;
+        for (auto &it : offsets)
+            ordered.push_back({it.second, it.first});
+        std::sort(ordered.begin(), ordered.end());
+
+        for (auto &it : ordered)
+        {
+            PackedAttribute attribute;
+            attribute.location = locations[it.second];
+            attribute.sourceOffset = it.first;
+            switch (types[it.second])
+            {
+            case VEC2:
+                attribute.components = 2;
+                break;
+            case VEC3:
+                attribute.components = 3;
+                break;
+            case VEC4:
+            case MAT2:
+                attribute.components = 4;
+                break;
+            default:
+                attribute.components = 1;
+                break;
+            }
+
+            std::string name = it.second;
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c)
+                           { return std::tolower(c); });
+            if (it.first == 0 && attribute.components >= 3)
+            {
+                attribute.encoding = positionEncoding;
+                attribute.isPosition = positionEncoding != VertexEncoding::Float;
+            }
+            else if (name.find("normal") != std::string::npos && attribute.components == 3)
+                attribute.encoding = VertexEncoding::Snorm10;
+            else if (name.find("color") != std::string::npos)
+                attribute.encoding = VertexEncoding::Unorm8;
+
+            attribute.offset = format.stride;
+            format.stride += GetPackedSize(attribute.encoding, attribute.components);
+            format.attributes.push_back(attribute);
+        }
+        format.sourceSize = shader->GetAttributeSize();
+        return format;
+    }
+    // En : Calculates the quantization range from the bounds of the positions.
+    // Tr : Konumların sınırlarından nicemleme aralığını hesaplar.
+    QuantizationRange CalculateQuantizationRange(glm::vec3 min, glm::vec3 max)
+    {
+        QuantizationRange range;
+        range.bias = (min + max) * 0.5f;
+        range.scale = glm::max((max - min) * 0.5f, glm::vec3(1e-6f));
+        return range;
+    }
+    // En : Encodes float vertices into the packed format.
+    // Tr : Float vertex'leri paketlenmiş formata kodlar.
+    void EncodeVertices(const VertexFormat &format, const QuantizationRange &range, const float *source, size_t vertexCount, unsigned char *destination)
+    {
+        for (const PackedAttribute &attribute : format.attributes)
+            EncodeAttribute(attribute, format, range, source, vertexCount, destination);
+    }
+    GLenum GetGLType(VertexEncoding encoding)
+    {
+        switch (encoding)
+        {
+        case VertexEncoding::Half:
+            return GL_HALF_FLOAT;
+        case VertexEncoding::Snorm16:
+            return GL_SHORT;
+        case VertexEncoding::Snorm10:
+            return GL_INT_2_10_10_10_REV;
+        case VertexEncoding::Unorm8:
+            return GL_UNSIGNED_BYTE;
+        default:
+            return GL_FLOAT;
+        }
+    }
+    unsigned int GetPackedSize(VertexEncoding encoding, int components)
+    {
+        switch (encoding)
+        {
+        case VertexEncoding::Half:
+        case VertexEncoding::Snorm16:
+            return components > 2 ? 8 : 4;
+        case VertexEncoding::Snorm10:
+        case VertexEncoding::Unorm8:
+            return 4;
+        default:
+            return components * sizeof(float);
+        }
+    }
+}
+#endif
\ No newline at end of file
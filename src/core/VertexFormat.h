@@ -0,0 +1,81 @@
+#ifndef VERTEX_FORMAT_H
+#define VERTEX_FORMAT_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace parseShape
+{
+    class Shader;
+
+    // En : Encodings a vertex attribute can be uploaded with.
+    // Tr : Bir vertex attribute'unun yüklenebileceği kodlamalar.
+    enum class VertexEncoding
+    {
+        Float,
+        // En : 16 bit float, positions are stored relative to the mesh bounds.
+        // Tr : 16 bit float, konumlar mesh sınırlarına göre saklanır.
+        Half,
+        // En : 16 bit signed normalized, positions are stored relative to the mesh bounds.
+        // Tr : 16 bit işaretli normalize, konumlar mesh sınırlarına göre saklanır.
+        Snorm16,
+        // En : 10_10_10_2 signed normalized, used for normals.
+        // Tr : 10_10_10_2 işaretli normalize, normaller için kullanılır.
+        Snorm10,
+        // En : 8 bit unsigned normalized, used for colors.
+        // Tr : 8 bit işaretsiz normalize, renkler için kullanılır.
+        Unorm8
+    };
+
+    // En : Where an attribute comes from in the float vertex and where it goes in the packed vertex.
+    // Tr : Bir attribute'un float vertex'te nereden geldiği ve paketlenmiş vertex'te nereye gittiği.
+    struct PackedAttribute
+    {
+        int location = 0, components = 0;
+        VertexEncoding encoding = VertexEncoding::Float;
+        // En : `sourceOffset` is in floats, `offset` is in bytes.
+        // Tr : `sourceOffset` float cinsinden, `offset` byte cinsindendir.
+        unsigned int sourceOffset = 0, offset = 0;
+        // En : True if the attribute is decoded with the per mesh position scale and bias.
+        // Tr : Attribute mesh başına konum ölçeği ve kayması ile çözülüyorsa true.
+        bool isPosition = false;
+    };
+
+    // En : Layout of a packed vertex buffer.
+    // Tr : Paketlenmiş bir vertex buffer'ının düzeni.
+    struct VertexFormat
+    {
+        std::vector<PackedAttribute> attributes;
+        // En : `stride` is the packed vertex size in bytes, `sourceSize` is the float vertex size in floats.
+        // Tr : `stride` paketlenmiş vertex boyutudur (byte), `sourceSize` float vertex boyutudur (float).
+        unsigned int stride = 0, sourceSize = 0;
+    };
+
+    // En : Maps the positions of a mesh into [-1, 1] as `(position - bias) / scale` when they are encoded,
+    // the shader decodes them back as `aPos * positionScale + positionBias`.
+    // Tr : Bir meshin konumlarını kodlanırken `(position - bias) / scale` olarak [-1, 1] aralığına eşler,
+    // shader onları `aPos * positionScale + positionBias` olarak geri çözer.
+    struct QuantizationRange
+    {
+        glm::vec3 scale = glm::vec3(1.0f), bias = glm::vec3(0.0f);
+    };
+
+    // En : Builds a packed format from the attributes of the shader.
+    // The attribute at offset 0 is the position, names containing "normal" and "color" are packed as normals and colors.
+    // Tr : Shader'ın attribute'larından paketlenmiş bir format oluşturur.
+    // 0 offsetindeki attribute konumdur, "normal" ve "color" içeren isimler normal ve renk olarak paketlenir.
+    VertexFormat CreateVertexFormat(Shader *shader, VertexEncoding positionEncoding = VertexEncoding::Snorm16);
+    // En : Calculates the quantization range of the positions.
+    // Tr : Konumların nicemleme aralığını hesaplar.
+    QuantizationRange CalculateQuantizationRange(glm::vec3 min, glm::vec3 max);
+    // En : Encodes `vertexCount` float vertices into `destination`, which must hold `vertexCount * format.stride` bytes.
+    // Tr : `vertexCount` float vertex'i `destination`'a kodlar, `destination` `vertexCount * format.stride` byte tutmalıdır.
+    void EncodeVertices(const VertexFormat &format, const QuantizationRange &range, const float *source, size_t vertexCount, unsigned char *destination);
+    GLenum GetGLType(VertexEncoding encoding);
+    // En : Returns the number of bytes an attribute takes in the packed vertex, always a multiple of 4.
+    // Tr : Bir attribute'un paketlenmiş vertex'te kapladığı byte sayısını döndürür, her zaman 4'ün katıdır.
+    unsigned int GetPackedSize(VertexEncoding encoding, int components);
+}
+#endif
\ No newline at end of file
@@ -2,85 +2,99 @@
 #define MECHANICAL_PART_MESH_CPP
 
 #include "MechanicalPartMesh.h"
+#include "../core/MeshBuilder.h"
+#include "../core/Primitive.h"
 
 #include <glm/glm.hpp>
+#include <algorithm>
 #include <vector>
 namespace parseShape
 {
     Mesh *CreateGear(int toothCount, int resolution, float innerRadius, float outerRadius, float height, float toothHeight, float toothWidth, int vertexSize)
     {
-        Mesh *mesh = new Mesh(resolution * 4, vertexSize);
+        MeshBuilder builder(vertexSize);
+        if (resolution < 3)
+            return builder.Build();
         float sectorStep = 4 * (22.0f / 7.0f) / resolution / 2;
-        int toothStep = resolution / toothCount;
+        int toothStep = std::max(1, resolution / std::max(1, toothCount));
+        int teeth = (resolution + toothStep * 2 - 1) / (toothStep * 2);
         float halfHeight = height / 2.0f;
-        for (int i = 0; i < resolution; i++)
-        {
-            float angle = sectorStep * i;
-            mesh->ChangeVertex(glm::vec3(cos(angle) * innerRadius, sin(angle) * innerRadius, halfHeight), i, 0);
-            mesh->ChangeVertex(glm::vec3(cos(angle) * outerRadius, sin(angle) * outerRadius, halfHeight), i + resolution, 0);
-            mesh->ChangeVertex(glm::vec3(cos(angle) * innerRadius, sin(angle) * innerRadius, -halfHeight), i + resolution * 2, 0);
-            mesh->ChangeVertex(glm::vec3(cos(angle) * outerRadius, sin(angle) * outerRadius, -halfHeight), i + resolution * 3, 0);
-        }
-        for (int i = 0; i < resolution - 1; i++)
+        const std::vector<glm::vec2> &sinCos = GetSinCosTable(resolution + toothStep + 1, sectorStep);
+
+        // En: The vertex and index counts are known up front, so everything is written in a single pass without reallocations.
+        // Tr: Vertex ve index sayıları önceden bilinir, bu yüzden her şey yeniden ayırma olmadan tek geçişte yazılır.
+        size_t vertexCount = (size_t)resolution * 4 + (size_t)teeth * (toothStep + 1) * 2;
+        size_t indexCount = (size_t)resolution * 12 + (size_t)teeth * toothStep * 12;
+        builder.Reserve(vertexCount, indexCount);
+        float *ring = builder.AddVertices(vertexCount), *tooth = ring + (size_t)resolution * 4 * vertexSize;
+        unsigned int *index = builder.AddIndices(indexCount);
+
+        size_t quarter = (size_t)resolution * vertexSize;
+        for (int i = 0; i < resolution; i++, ring += vertexSize)
         {
-            mesh->AddIndices(i, i + resolution, i + 1);
-            mesh->AddIndices(i + 1, i + resolution, i + resolution + 1);
-            mesh->AddIndices(i + resolution * 2, i + resolution * 2 + 1, i + resolution * 3);
-            mesh->AddIndices(i + resolution * 3, i + resolution * 2 + 1, i + resolution * 3 + 1);
+            glm::vec2 inner = sinCos[i] * innerRadius, outer = sinCos[i] * outerRadius;
+            ring[0] = ring[quarter * 2] = inner.x;
+            ring[1] = ring[quarter * 2 + 1] = inner.y;
+            ring[quarter] = ring[quarter * 3] = outer.x;
+            ring[quarter + 1] = ring[quarter * 3 + 1] = outer.y;
+            ring[2] = ring[quarter + 2] = halfHeight;
+            ring[quarter * 2 + 2] = ring[quarter * 3 + 2] = -halfHeight;
         }
-        mesh->AddIndices(resolution - 1, resolution * 2 - 1, 0);
-        mesh->AddIndices(0, resolution * 2 - 1, resolution);
-        mesh->AddIndices(resolution * 2 - 1, resolution * 3 - 1, resolution * 2);
-        mesh->AddIndices(resolution * 2, resolution * 3 - 1, resolution * 3);
-        for (unsigned int i = 0; i < resolution; i += toothStep * 2)
+        const unsigned int r = resolution;
+        for (unsigned int i = 0; i + 1 < r; i++, index += 12)
         {
-            for (unsigned int j = 0; j <= toothStep; j++)
-            {
-                float angle = sectorStep * (i + j + 1);
-                mesh->AddVertex({std::cos(angle) * toothHeight,
-                                 std::sin(angle) * toothHeight,
-                                 halfHeight,
-                                 0,
-                                 0,
-                                 0,
-                                 0,
-                                 0,
-                                 0});
-                if (j)
-                {
-                    unsigned int index = mesh->GetVertexCount() - 1;
-                    mesh->AddIndices({i + j + resolution, index, i + j + resolution + 1});
-                    mesh->AddIndices({i + j + resolution, index, index - 1});
-                }
-            }
+            const unsigned int quad[12] = {i, i + r, i + 1,
+                                           i + 1, i + r, i + r + 1,
+                                           i + r * 2, i + r * 2 + 1, i + r * 3,
+                                           i + r * 3, i + r * 2 + 1, i + r * 3 + 1};
+            std::copy(quad, quad + 12, index);
         }
-        for (unsigned int i = 0; i < resolution; i += toothStep * 2)
+        const unsigned int closing[12] = {r - 1, r * 2 - 1, 0,
+                                          0, r * 2 - 1, r,
+                                          r * 2 - 1, r * 3 - 1, r * 2,
+                                          r * 2, r * 3 - 1, r * 3};
+        index = std::copy(closing, closing + 12, index);
+
+        unsigned int vertex = r * 4;
+        for (int side = 0; side < 2; side++)
         {
-            for (unsigned int j = 0; j <= toothStep; j++)
+            unsigned int base = side ? 3 * r : r;
+            float z = side ? -halfHeight : halfHeight;
+            for (unsigned int i = 0; i < r; i += toothStep * 2)
             {
-                float angle = sectorStep * (i + j + 1);
-                mesh->AddVertex({std::cos(angle) * toothHeight,
-                                 std::sin(angle) * toothHeight,
-                                 -halfHeight,
-                                 0,
-                                 0,
-                                 0,
-                                 0,
-                                 0,
-                                 0});
-                if (j)
+                for (unsigned int j = 0; j <= (unsigned int)toothStep; j++, vertex++, tooth += vertexSize)
                 {
-                    unsigned int index = mesh->GetVertexCount() - 1;
-                    mesh->AddIndices({i + j + 3 * resolution, index, i + j + 3 * resolution + 1});
-                    mesh->AddIndices({i + j + 3 * resolution, index, index - 1});
+                    glm::vec2 point = sinCos[i + j + 1] * toothHeight;
+                    tooth[0] = point.x;
+                    tooth[1] = point.y;
+                    tooth[2] = z;
+                    if (j)
+                    {
+                        const unsigned int triangles[6] = {i + j + base, vertex, i + j + base + 1,
+                                                           i + j + base, vertex, vertex - 1};
+                        index = std::copy(triangles, triangles + 6, index);
+                    }
                 }
             }
         }
-        size_t actualSize = mesh->GetVertexSize();
-        for (size_t i = 0; i < actualSize; i++)
-        {
-            mesh->AddVertex({});
-        }
+        return builder.Build();
+    }
+    Mesh *InstanceGear(int toothCount, int resolution, float innerRadius, float outerRadius, float height, float toothHeight, float toothWidth, int vertexSize)
+    {
+        if (innerRadius <= 0.0f)
+            return CreateGear(toothCount, resolution, innerRadius, outerRadius, height, toothHeight, toothWidth, vertexSize);
+
+        PrimitiveKey key;
+        key.type = PrimitiveType::Gear;
+        key.resolution = resolution;
+        key.count = toothCount;
+        key.vertexSize = vertexSize;
+        key.ratios[0] = outerRadius / innerRadius;
+        key.ratios[1] = toothHeight / innerRadius;
+        Mesh *mesh = GetPrimitiveCache().Instance(key, [=]()
+                                                  { return CreateGear(toothCount, resolution, 1.0f, key.ratios[0], 1.0f, key.ratios[1], toothWidth / innerRadius, vertexSize); });
+        if (mesh)
+            mesh->SetScale(glm::vec3(innerRadius, innerRadius, height));
         return mesh;
     }
     Mesh *CreateHelicalGear(int toothCount, float radius, float height, float thickness, float toothHeight, float toothWidth, float toothSlope, float helixAngle, int vertexSize)
@@ -4,6 +4,9 @@
 namespace parseShape
 {
     Mesh *CreateGear(int toothCount, int resolution, float innerRadius, float outerRadius, float height, float toothHeight, float toothWidth, int vertexSize = 3);
+    // En : Creates the gear from a cached unit gear, the radii and the height are applied through the scale of the mesh.
+    // Tr : Dişliyi önbellekteki birim dişliden oluşturur, yarıçaplar ve yükseklik meshin ölçeği ile uygulanır.
+    Mesh *InstanceGear(int toothCount, int resolution, float innerRadius, float outerRadius, float height, float toothHeight, float toothWidth, int vertexSize = 3);
     Mesh *CreateHelicalGear(int toothCount, float radius, float height, float thickness, float toothHeight, float toothWidth, float toothSlope, float helixAngle, int vertexSize = 3);
 
 }